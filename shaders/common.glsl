@@ -0,0 +1,674 @@
+#define MAX_RECURSIVE_DEPTH 2000
+#define MAX_BOUNCES 1
+#define EPS 0.0001
+#define SDF_LIMIT 0.0001
+#define VARIANCE_WEIGHT 8.0
+#define VARIANCE_BLEND 0.25
+#define VARIANCE_MAX_SAMPLES 4
+
+#define SDF_SPHERE 0
+#define SDF_JULIA 1
+#define SDF_MANDELBULB 2
+#define SDF_BOX 3
+
+layout(set = 0, binding = 0) uniform UniformBufferObject {
+    float width;
+    float height;
+    uint triangles;
+    vec2 viewport;
+    uint bvhsize;
+	float frameless;
+    uint sdfsize;
+    float sdfsmooth;
+    uint maxmarches;
+    uint lightssize;
+    uint accumulate;
+    uint variance;
+    uint reproject;
+    vec4 previous[4];
+    uint denoise;
+    uint interleave;
+    uint phase;
+    uint settled;
+    uint slot;
+} ubo;
+
+// per frame values, queue and samp are only used by the wavefront kernels
+// sequence counts frames and origin is the corner of the visible region the 2d kernels are dispatched over
+layout(push_constant) uniform FramePushConstants {
+    vec3 position;
+    float fov;
+    vec3 u;
+    float frametime;
+    vec3 v;
+    float time;
+    vec3 w;
+    uint sequence;
+    uint samples;
+    uint queue;
+    uint samp;
+    uvec2 origin;
+} frame;
+
+#include "sampler.glsl"
+
+// feature toggles, each config combination gets its own pipeline variant
+layout(constant_id = 2) const bool SHADOWS = true;
+layout(constant_id = 3) const bool REFLECTIONS = true;
+layout(constant_id = 4) const bool LIGHTING = true;
+layout(constant_id = 5) const bool RAYTRACE = true;
+layout(constant_id = 6) const bool SDF = false;
+layout(constant_id = 7) const bool ANTIALIASING = false;
+
+struct Ray {
+    vec3 position;
+    vec3 direction;
+};
+
+struct Hit {
+    float distance;
+    uint material;
+    vec3 normal;
+    vec3 position;
+};
+
+struct Triangle {
+    vec3 a;
+    vec3 b;
+    vec3 c;
+    uint material;
+};
+
+struct Material {
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+    float reflection;
+    float refraction;
+    float rindex;
+    float transparency;
+    float shiny;
+    float glossy;
+};
+
+struct PointLight {
+    vec3 position;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+struct NodeBVH {
+    vec3 min;
+    vec3 max;
+    uint config;
+    uint left;
+    uint right;
+};
+
+struct SDFPrimitive {
+    uint type;
+    vec3 origin;
+    float scale;
+	vec3 dim;
+};
+
+// seconds since each pixel was last traced
+layout(set = 0, binding = 1, r32f) uniform image2D ageImage;
+
+layout(set = 0, binding = 2, rgba8) uniform image2D outputImage;
+
+layout(set = 0, binding = 3) readonly buffer TriangleSSBOIn {
+    Triangle triangleIn[ ];
+};
+
+layout(set = 0, binding = 4) readonly buffer MaterialSSBOIn {
+    Material materialIn[ ];
+};
+
+layout(set = 0, binding = 5) readonly buffer BVHSSBOIn {
+    NodeBVH bvhIn[ ];
+};
+
+layout(set = 0, binding = 6) readonly buffer SDFSSBOIn {
+    SDFPrimitive sdfIn[ ];
+};
+
+layout(set = 0, binding = 7) readonly buffer LightSSBOIn {
+    PointLight lightIn[ ];
+};
+
+layout(set = 0, binding = 13, rgba32f) uniform image2D accumulationImage;
+
+// running luminance moments per pixel, x = mean, y = mean square, w = updates seen
+layout(set = 0, binding = 15, rgba16f) uniform image2D varianceImage;
+
+// last traced color with its primary hit depth in alpha, 0 = empty and negative = sky
+layout(set = 0, binding = 16, rgba32f) uniform image2D historyImage;
+
+// denoiser edge stops, primary albedo and the hit normal with its depth in w
+layout(set = 0, binding = 19, rgba16f) uniform image2D albedoImage;
+layout(set = 0, binding = 20, rgba16f) uniform image2D normalImage;
+
+// demodulated color between denoise passes, even passes write ping and odd ones pong
+// reprojection borrows them to warp the edge stops before the denoiser runs
+layout(set = 0, binding = 21, rgba16f) uniform image2D pingImage;
+layout(set = 0, binding = 22, rgba16f) uniform image2D pongImage;
+
+// last traced color of every pixel in interleaved mode, alpha 0 = not traced yet
+layout(set = 0, binding = 23, rgba16f) uniform image2D latticeImage;
+
+bool stack_failure = false;
+float primary_depth = -1.0;
+vec3 primary_normal = vec3(0.0);
+vec3 primary_albedo = vec3(1.0);
+
+bool cut_viewport(uvec2 pixel) {
+    if (ubo.viewport.x != 0 &&
+        (pixel.x < ceil(((ubo.width - ubo.viewport.x) / 2.0)) ||
+        (pixel.x > ceil(((ubo.width + ubo.viewport.x) / 2.0))))) return true;
+    if (ubo.viewport.y != 0 &&
+        (pixel.y < ceil(((ubo.height - ubo.viewport.y) / 2.0)) ||
+        (pixel.y > ceil(((ubo.height + ubo.viewport.y) / 2.0))))) return true;
+    return false;
+}
+
+uint sample_base(ivec2 pixel) {
+    // the accumulated count walks the sequence contiguously, whatever each frame's sample count was
+    if (ubo.accumulate == 0) return 0;
+    return uint(imageLoad(accumulationImage, pixel).w);
+}
+
+vec2 sample_jitter(uvec2 pixel, uint index) {
+    if (ubo.accumulate == 0) return vec2(0.0);
+    return sampler_sobol(pixel, index) - 0.5;
+}
+
+void skip_color(ivec2 pixel) {
+    if (ubo.accumulate == 0 && ubo.reproject == 0 && ubo.interleave == 0) imageStore(outputImage, pixel, vec4(0.0));
+}
+
+uint bayer2(uvec2 pixel) {
+    return (((pixel.x ^ pixel.y) & 1u) << 1) | (pixel.y & 1u);
+}
+
+uint lattice_index(uvec2 pixel) {
+    // consecutive phases land far apart, so every frame covers the image evenly
+    if (ubo.interleave == 2) return (pixel.x + pixel.y) & 1u;
+    if (ubo.interleave == 4) return bayer2(pixel);
+    return bayer2(pixel) * 4u + bayer2(pixel >> 1);
+}
+
+bool lattice_traced(uvec2 pixel) {
+    return lattice_index(pixel) == ubo.phase;
+}
+
+float pixel_error(ivec2 pixel) {
+    // relative deviation of the pixel, unseen pixels count as noisy
+    if (ubo.variance == 0) return 0.0;
+    vec4 moments = imageLoad(varianceImage, pixel);
+    if (moments.w < 2.0) return 1.0;
+    float variance = max(moments.y - moments.x * moments.x, 0.0);
+
+    // an accumulated pixel shows the mean, whose error shrinks with every sample it holds
+    variance /= float(max(sample_base(pixel), 1u));
+    return min(sqrt(variance) / (moments.x + 0.05), 1.0);
+}
+
+void track_variance(ivec2 pixel, vec3 color) {
+    if (ubo.variance == 0) return;
+    float luminance = dot(color, vec3(0.2126, 0.7152, 0.0722));
+    vec4 moments = imageLoad(varianceImage, pixel);
+    float blend = max(VARIANCE_BLEND, 1.0 / (moments.w + 1.0));
+    moments.xy = mix(moments.xy, vec2(luminance, luminance * luminance), blend);
+    moments.w = min(moments.w + 1.0, 255.0);
+    imageStore(varianceImage, pixel, moments);
+}
+
+uint sample_count(ivec2 pixel) {
+    // extra samples only differ when jittered, which needs accumulation
+    if (ubo.accumulate == 0) return 1;
+    return 1 + uint(round(pixel_error(pixel) * float(VARIANCE_MAX_SAMPLES - 1)));
+}
+
+void store_color(ivec2 pixel, vec3 color) {
+    track_variance(pixel, color);
+    if (ubo.denoise != 0) {
+        imageStore(albedoImage, pixel, vec4(primary_albedo, 1.0));
+        imageStore(normalImage, pixel, vec4(primary_normal, primary_depth));
+    }
+
+    // accumulated pixels keep their sample count in alpha
+    if (ubo.accumulate != 0) {
+        imageStore(accumulationImage, pixel, imageLoad(accumulationImage, pixel) + vec4(color, 1.0));
+    } else if (ubo.reproject != 0) {
+        imageStore(historyImage, pixel, vec4(color, primary_depth));
+    } else if (ubo.interleave != 0) {
+        imageStore(latticeImage, pixel, vec4(color, 1.0));
+    } else if (ubo.frameless < 1.0) {
+        imageStore(outputImage, pixel, vec4(color, 0.1));
+    } else {
+        imageStore(outputImage, pixel, vec4(color, 1.0));
+    }
+}
+
+vec3 camera_direction(vec2 rg, vec3 cu, vec3 cv, vec3 cw, float fov) {
+	float r = ubo.width / 2.0;
+	float b = ubo.height / 2.0;
+	float l = -1.0 * r;
+	float t = -1.0 * b;
+    float u = l + ((r - l) * (float(rg.x) + 0.5)) / ubo.width;
+    float v = b + ((t - b) * (float(rg.y) + 0.5)) / ubo.height;
+	float d = (cos(fov / 2.0) / sin(fov / 2.0)) * r;
+    return normalize((cu * u) + (cv * v) - (cw * d));
+}
+
+Ray create_ray(vec2 rg) {
+    Ray ray;
+    ray.direction = camera_direction(rg, frame.u, frame.v, frame.w, frame.fov);
+    ray.position = frame.position;
+    return ray;
+}
+
+bool triangle_intersect(Ray ray, uint triangle_ind, inout Hit hit) {
+    Triangle tri = triangleIn[triangle_ind];
+    hit.normal = normalize(cross(tri.b - tri.a, tri.c - tri.b));
+    hit.distance = dot(tri.a - ray.position, hit.normal) / dot(ray.direction, hit.normal);
+    if (hit.distance > 0) {
+        vec3 hit_at = ray.position + (ray.direction * hit.distance);
+        if (dot(cross(tri.b - tri.a, hit_at - tri.a), hit.normal) > 0 &&
+            dot(cross(tri.c - tri.b, hit_at - tri.b), hit.normal) > 0 &&
+            dot(cross(tri.a - tri.c, hit_at - tri.c), hit.normal) > 0) {
+            hit.material = tri.material;
+            hit.position = ray.position + (ray.direction * hit.distance);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool aabb_intersect(Ray ray, uint node_ind) {
+    float entrance = 0.0;
+    float exit = 3.402823466e+38;
+    for (int i = 0; i < 3; i++) {
+        float slab_a = bvhIn[node_ind].min[i];
+        float slab_b = bvhIn[node_ind].max[i];
+        float inv_dir = 1.0 / ray.direction[i];
+        float origin = ray.position[i];
+        float closest = (slab_a - origin) * inv_dir;
+        float farthest = (slab_b - origin) * inv_dir;
+        if (farthest < closest) {
+            float temp = farthest;
+            farthest = closest;
+            closest = temp;
+        }
+        if (farthest < entrance || closest > exit) return false;
+        exit = farthest < exit ? farthest : exit;
+        entrance = closest > entrance ? closest : entrance;
+    }
+    return true;
+}
+
+Hit raytrace(Ray ray) {
+    Hit hit;
+    hit.distance = -1.0;
+    if (ubo.bvhsize == 0) return hit;
+    if (!aabb_intersect(ray, 0)) return hit;
+    uint stack[MAX_RECURSIVE_DEPTH];
+    int stack_ptr = 0;
+    stack[stack_ptr++] = 0;
+    while (stack_ptr > 0) {
+        NodeBVH node = bvhIn[stack[--stack_ptr]];
+        if (stack_ptr >= MAX_RECURSIVE_DEPTH - 1) { stack_failure = true; break; }
+        if (node.config == 0) {
+            Hit trihit;
+            if (triangle_intersect(ray, node.left, trihit)) {
+                if (hit.distance == -1.0 || trihit.distance < hit.distance) {
+                    hit = trihit;
+                }
+            }
+        } else if (node.config == 1) {
+            if (aabb_intersect(ray, node.left))
+                stack[stack_ptr++] = node.left;
+        } else if (node.config == 2) {
+            if (aabb_intersect(ray, node.right))
+                stack[stack_ptr++] = node.right;
+        } else {
+            if (aabb_intersect(ray, node.left))
+                stack[stack_ptr++] = node.left;
+            if (aabb_intersect(ray, node.right))
+                stack[stack_ptr++] = node.right;
+        }
+    }
+    return hit;
+}
+
+bool is_shadowed(Hit hit, PointLight light, vec3 light_direction, float light_distance) {
+    if (hit.distance < 0.0 || !SHADOWS) return false;
+    if (dot(hit.normal, light_direction) < 0.0) return true;
+    bool shadowed = false;
+    Ray ray;
+    ray.position = light.position;
+    ray.direction = light_direction * -1.0;
+    Hit shit = raytrace(ray);
+    shadowed = shit.distance > 0.0 && shit.distance < light_distance - EPS;
+    return shadowed;
+}
+
+vec3 dshade(Hit hit) {
+    float dif = clamp(dot(hit.normal, vec3(0.7,0.6,0.4)), 0.0, 1.0);
+    float amb = 0.5 + 0.5 * dot(hit.normal, vec3(0.0,0.8,0.6));
+    return sqrt(vec3(0.2,0.3,0.4) * amb + vec3(0.8,0.7,0.5) * dif);
+}
+
+vec3 shade_lit(Ray ray, Hit hit, PointLight light, bool shadowed) {
+    vec3 color = abs(ray.direction) / 1.0;
+    if (hit.distance > 0) {
+        // calculate light stuff
+        vec3 light_direction = normalize(hit.position - light.position) * -1.0;
+
+        // material
+        Material material = materialIn[hit.material];
+
+        // ambient light
+        color = material.ambient * light.ambient;
+
+        // diffuse light
+        if (!shadowed)
+            color += material.diffuse * light.diffuse * dot(light_direction, hit.normal);
+
+        // specular light
+        vec3 reflection = normalize(reflect(light_direction, hit.normal));
+        float specular_const = dot(reflection, ray.direction);
+        if (specular_const >= 0 && !shadowed)
+            color += light.specular * material.specular * pow(specular_const, material.shiny);
+
+        // divide to ensure not above 1, 1, 1
+        color /= 3.0;
+    }
+    return color;
+}
+
+vec3 shade(Ray ray, Hit hit, PointLight light) {
+    bool shadowed = false;
+    if (hit.distance > 0) {
+        vec3 light_direction = normalize(hit.position - light.position) * -1.0;
+        float light_distance = length(hit.position - light.position);
+        shadowed = is_shadowed(hit, light, light_direction, light_distance);
+    }
+    return shade_lit(ray, hit, light, shadowed);
+}
+
+PointLight default_light() {
+    PointLight light;
+    light.position = frame.position;
+    light.ambient = vec3(1.0, 1.0, 1.0);
+    light.diffuse = vec3(1.0, 1.0, 1.0);
+    light.specular = vec3(1.0, 1.0, 1.0);
+    return light;
+}
+
+void draw_light(Ray ray, Hit hit, PointLight light, inout vec3 color) {
+    float light_radius = 1.0;
+    vec3 l_t = ray.position + (dot(light.position - ray.position, ray.direction) * ray.direction);
+    float l_d = length(l_t - light.position);
+    vec3 light_color = (light.ambient + light.diffuse + light.specular) / 3.0;
+    if (l_t != ray.position &&
+        (hit.distance <= 0 || length(l_t - ray.position) < hit.distance) && 
+        l_d < light_radius) {
+        float brilliance = 1.0 - (l_d / light_radius);
+        color = mix(color, light_color, pow(brilliance, 5));
+    }
+}
+
+void reflect_color(Ray ray, Hit hit, int bounces, inout vec3 color) {
+    if (hit.distance >= 0.0) {
+        Material material = materialIn[hit.material];
+        if (material.reflection > 0.0) {
+            vec3 colors[MAX_BOUNCES];
+            float reflectionvals[MAX_BOUNCES];
+            int num_colors = 0;
+            Hit rhit = hit;
+            Ray rray = ray;
+            for (int i = 0; i < bounces; i++) {
+                rray.direction = reflect(rray.direction, rhit.normal);
+                rray.position = rhit.position + (rray.direction * EPS);
+                rhit = raytrace(rray);
+                rhit.position = frame.position + (rray.direction * rhit.distance); // should we keep this in? should this be using frame.position...
+                PointLight light = default_light();
+                reflectionvals[num_colors] = material.reflection;
+                colors[num_colors] = abs(rray.direction) / 1.0;
+                if (rhit.distance >= 0.0) {
+                    uint num_lights = max(1, ubo.lightssize);
+                    PointLight light;
+                    colors[num_colors] = vec3(0.0);
+                    for (uint i = 0; i < num_lights; i++) {
+                        if (ubo.lightssize > 0) {
+                            light = lightIn[i];
+                        } else {
+                            light = default_light();
+                        }
+                        colors[num_colors] += shade(ray, rhit, light);
+                    }
+                } else if (rhit.distance >= 0.0) {
+                    color = dshade(hit);
+                }
+                num_colors++;
+                if (rhit.distance <= 0.0 || materialIn[rhit.material].reflection <= 0.0) break;
+                material = materialIn[rhit.material];
+            }
+            for (int i = num_colors - 1; i >= 0; i--) {
+                if (i == 0) {
+                    color = mix(color, colors[i], reflectionvals[i]);
+                } else {
+                    colors[i - 1] = mix(colors[i - 1], colors[i], reflectionvals[i]);
+                }
+            }
+        }
+    }
+}
+
+float sdf_sphere(SDFPrimitive sphere, vec3 position) {
+    return length(sphere.origin - position) - sphere.scale;
+}
+
+vec4 qsqr(vec4 a) {
+    return vec4(a.x * a.x - a.y * a.y - a.z * a.z - a.w * a.w,
+        2.0 * a.x * a.y,
+        2.0 * a.x * a.z,
+        2.0 * a.x * a.w);
+}
+
+float sdf_julia(SDFPrimitive julia, vec3 position) {
+    vec4 c = 0.45*cos( vec4(0.5,3.9,1.4,1.1) + frame.time*.15*vec4(1.2,1.7,1.3,2.5) ) - vec4(0.3,0.0,0.0,0.0);
+    vec4 z = vec4(position.xyz, 0.0);
+    float md2 = 1.0;
+    float mz2 = dot(z, z);
+    vec3 z_abs = abs(z.xyz);
+    vec4 trap = vec4(z_abs.xyz, dot(z, z));
+    for (int i = 0; i < 11; i++) {
+        md2 *= 4.0 * mz2;
+        z = qsqr(z) + c;
+        z_abs = abs(z.xyz);
+        trap = vec4(z_abs.xyz, dot(z, z));
+        mz2 = dot(z, z);
+        if (mz2 > 4.0) break;
+    }
+    return 0.25 * sqrt(mz2 / md2) * log(mz2);
+}
+
+float sdf_mandelbulb(SDFPrimitive bulb, vec3 position) {
+    float power = frame.time;
+    float dr = 1.0;
+    float r = 0.0;
+    vec3 z = position;
+    for (int i = 0; i < 15; i++) {
+        r = length(z);
+        if (r > 2.0)
+            break;
+        float theta = acos(z.z / r);
+        float phi = atan(z.y, z.x);
+        dr = pow(r, power - 1.0) * power * dr + 1.0;
+
+        float zr = pow(r, power);
+        theta = theta*power;
+        phi = phi*power;
+
+        z = zr * vec3(sin(theta) * cos(phi), sin(phi) * sin(theta), cos(theta));
+        z += position;
+    }
+
+    return 0.5 * log(r) * r / dr;
+}
+
+float sdf_box(SDFPrimitive box, vec3 position) {
+	vec3 q = abs(box.origin - position) - box.dim;
+	return length(max(q,0.0)) + min(max(q.x,max(q.y,q.z)),0.0);
+}
+
+float smin(float a, float b, float k) {
+    k *= 1.0;
+    float r = exp2(-a/k) + exp2(-b/k);
+    return -k*log2(r);
+}
+
+float sdf(vec3 position) {
+    float distance = 0.0;
+	bool dinit = false;
+    for (uint i = 0; i < ubo.sdfsize; i++) {
+        SDFPrimitive prim = sdfIn[i];
+        float curr_dist = 0.0;
+        if (prim.type == SDF_SPHERE) {
+            curr_dist = sdf_sphere(prim, position);
+        } else if (prim.type == SDF_JULIA) {
+            curr_dist = sdf_julia(prim, position);
+        } else if (prim.type == SDF_MANDELBULB) {
+            curr_dist = sdf_mandelbulb(prim, position);
+        } else if (prim.type == SDF_BOX) {
+			curr_dist = sdf_box(prim, position);
+		}
+		if (!dinit) {
+			dinit = true;
+			distance = curr_dist;
+			continue;
+		}
+        if (ubo.sdfsmooth == 0.0)
+            distance = min(curr_dist, distance); // union, change based on intersection or whatever
+        else
+            distance = smin(curr_dist, distance, ubo.sdfsmooth);
+    }
+    return distance;
+}
+
+vec3 sdf_normal(vec3 position) {
+    vec2 k = vec2(1,-1);
+    return normalize(
+        k.xyy*sdf(position + k.xyy*EPS) + 
+        k.yyx*sdf(position + k.yyx*EPS) + 
+        k.yxy*sdf(position + k.yxy*EPS) + 
+        k.xxx*sdf(position + k.xxx*EPS));
+}
+
+Hit raymarch(Ray ray) {
+    Hit hit;
+    hit.distance = -1.0;
+    hit.position = ray.position;
+    float last_march = -1.0;
+    for (uint i = 0; i < ubo.maxmarches; i++) {
+        float curr_march = sdf(ray.position);
+        if (curr_march <= SDF_LIMIT) {
+            hit.distance = length(ray.position - hit.position);
+            hit.position = ray.position;
+            hit.normal = sdf_normal(ray.position);
+            return hit;
+        }
+        ray.position += ray.direction * curr_march;
+        last_march = curr_march;
+    }
+    return hit;
+}
+
+vec3 raycolor(vec2 ray_coordinate) {
+	// create ray
+    Ray ray = create_ray(ray_coordinate);
+
+    // colors
+    vec3 color = abs(ray.direction) / 1.0;
+
+    // trace/march
+    Hit hit;
+    hit.distance = -1.0;
+    uint num_lights = max(1, ubo.lightssize);
+    if (RAYTRACE) {
+        hit = raytrace(ray);
+        if (hit.distance > 0.0) {
+            PointLight light;
+            if (LIGHTING) {
+                color = vec3(0.0, 0.0, 0.0);
+                for (uint i = 0; i < num_lights; i++) {
+                    if (ubo.lightssize > 0) {
+                        light = lightIn[i];
+                    } else {
+                        light = default_light();
+                    }
+                    color += shade(ray, hit, light);
+                }
+            } else {
+                color = dshade(hit);
+            }
+            if (REFLECTIONS) reflect_color(ray, hit, MAX_BOUNCES, color);
+        }
+    } else if (SDF) {
+        hit = raymarch(ray);
+        if (hit.distance > 0.0) {
+            color = dshade(hit);
+        }
+    }
+    primary_depth = hit.distance > 0.0 ? hit.distance : -1.0;
+    primary_normal = hit.distance > 0.0 ? hit.normal : vec3(0.0);
+    primary_albedo = RAYTRACE && hit.distance > 0.0 ? materialIn[hit.material].diffuse : vec3(1.0);
+    for (uint i = 0; i < ubo.lightssize; i++)
+	    draw_light(ray, hit, lightIn[i], color);
+	
+	return color;
+}
+
+bool select_pixel(uvec2 pixel) {
+	// interleaved frames trace a fixed lattice instead of rolling
+	float age = imageLoad(ageImage, ivec2(pixel)).r + frame.frametime;
+	if (ubo.interleave != 0) {
+		bool traced = lattice_traced(pixel);
+		imageStore(ageImage, ivec2(pixel), vec4(traced ? 0.0 : age));
+		return traced;
+	}
+
+	// age the pixel and roll whether it is traced this frame, noisy pixels age faster
+	float weight = 1.0 + VARIANCE_WEIGHT * pixel_error(ivec2(pixel));
+	float chance = 1.0 - pow(1.0 - ubo.frameless, age * weight);
+	bool update_signal = sampler_threshold(pixel) < chance;
+	imageStore(ageImage, ivec2(pixel), vec4(update_signal ? 0.0 : age));
+	return update_signal;
+}
+
+void trace_pixel(uvec2 pixel) {
+	uint samples = sample_count(ivec2(pixel));
+	uint base = sample_base(ivec2(pixel));
+	for (uint s = 0; s < samples; s++) {
+		// calculate ray color
+		vec3 color = vec3(0, 0, 0);
+		vec2 base_ray = vec2(pixel) + sample_jitter(pixel, base + s);
+		if (!ANTIALIASING) {
+			color = raycolor(base_ray);
+		} else {
+			color += raycolor(base_ray + vec2(-0.5, -0.5));
+			color += raycolor(base_ray + vec2(0.5, 0.5));
+			color /= 2.0;
+		}
+
+		// failures
+		if (stack_failure) color = vec3(1.0, 0.0, 0.0);
+
+		// write to image
+		store_color(ivec2(pixel), color);
+	}
+}
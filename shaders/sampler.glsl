@@ -0,0 +1,57 @@
+// every stochastic choice draws from here, one pcg stream per pixel and purpose
+// plus low discrepancy sequences where the sample count is known
+#define SAMPLER_JITTER 1u
+
+// golden ratio and the r2 plastic number pair, scaled to 32 bit fixed point
+#define SAMPLER_GOLDEN 2654435769u
+#define SAMPLER_R2_X 3242174889u
+#define SAMPLER_R2_Y 2447445414u
+
+uint sampler_state = 0u;
+
+uint pcg_hash(uint v) {
+    uint state = v * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+void sampler_seed(uvec2 pixel, uint stream) {
+    sampler_state = pcg_hash(pixel.x ^ pcg_hash(pixel.y ^ pcg_hash(stream)));
+}
+
+uint sampler_uint() {
+    uint state = sampler_state;
+    sampler_state = state * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+float sampler_unit(uint bits) {
+    return float(bits >> 8) * (1.0 / 16777216.0);
+}
+
+float sampler_float() {
+    return sampler_unit(sampler_uint());
+}
+
+uint sobol_second(uint index) {
+    // second sobol dimension, the first is the bit reversed index
+    uint result = 0u;
+    for (uint v = 1u << 31; index != 0u; index >>= 1, v ^= v >> 1) {
+        if ((index & 1u) != 0u) result ^= v;
+    }
+    return result;
+}
+
+vec2 sampler_sobol(uvec2 pixel, uint index) {
+    // xor scrambling per pixel and swap keeps every power of two prefix stratified
+    sampler_seed(pixel, SAMPLER_JITTER ^ (ubo.slot << 16));
+    uint x = bitfieldReverse(index) ^ sampler_uint();
+    uint y = sobol_second(index) ^ sampler_uint();
+    return vec2(sampler_unit(x), sampler_unit(y));
+}
+
+float sampler_threshold(uvec2 pixel) {
+    // r2 dither spreads each frame's picks evenly, the golden step spreads each pixel's over time
+    return sampler_unit(pixel.x * SAMPLER_R2_X + pixel.y * SAMPLER_R2_Y + frame.sequence * SAMPLER_GOLDEN);
+}
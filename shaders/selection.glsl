@@ -0,0 +1,8 @@
+#define SELECT_GROUP_SIZE 64
+
+// indirect args for the trace, then the pixels picked this frame
+layout(set = 0, binding = 14) buffer SelectionSSBO {
+    uint selectArgs[3];
+    uint selectCount;
+    uint selectedIn[ ];
+};
@@ -0,0 +1,80 @@
+#define WAVE_GROUP_SIZE 64
+#define WAVE_MAX_LIGHTS 32
+
+#define WAVE_QUEUE_PRIMARY 0
+#define WAVE_QUEUE_SECONDARY 1
+
+#define WAVE_SKIPPED 0.0
+#define WAVE_TRACED 1.0
+#define WAVE_FAILED 2.0
+#define WAVE_CUT 3.0
+
+struct WaveRay {
+    vec4 origin; // w is the reflection factor
+    vec4 direction; // w is the pixel index
+    vec4 view; // camera ray direction, w is the camera hit distance
+    vec4 local; // color under the reflection
+};
+
+struct WaveHit {
+    vec4 position; // w is the hit distance
+    vec4 normal; // w is the material
+};
+
+layout(set = 0, binding = 8) buffer WaveCounterSSBO {
+    uint counts[2];
+    uvec4 args[2];
+};
+
+layout(set = 0, binding = 9) buffer WaveQueueSSBO {
+    WaveRay queueIn[ ];
+};
+
+layout(set = 0, binding = 10) buffer WaveHitSSBO {
+    WaveHit hitIn[ ];
+};
+
+layout(set = 0, binding = 11) buffer WaveVisibilitySSBO {
+    uint visibilityIn[ ];
+};
+
+layout(set = 0, binding = 12) buffer WavePixelSSBO {
+    vec4 pixelIn[ ];
+};
+
+uint wave_capacity() {
+    return uint(ubo.width) * uint(ubo.height);
+}
+
+uint wave_slot(uint queue, uint index) {
+    return queue * wave_capacity() + index;
+}
+
+PointLight wave_light(uint i) {
+    if (ubo.lightssize > 0) return lightIn[i];
+    return default_light();
+}
+
+Hit wave_unpack_hit(WaveHit wh) {
+    Hit hit;
+    hit.distance = wh.position.w;
+    hit.position = wh.position.xyz;
+    hit.normal = wh.normal.xyz;
+    hit.material = floatBitsToUint(wh.normal.w);
+    return hit;
+}
+
+uint wave_pixel(WaveRay wr) {
+    return floatBitsToUint(wr.direction.w);
+}
+
+void wave_fail(WaveRay wr) {
+    if (stack_failure) pixelIn[wave_pixel(wr)].w = WAVE_FAILED;
+}
+
+bool wave_shadowed(uint visibility, uint i, Hit hit, PointLight light) {
+    if (i < WAVE_MAX_LIGHTS) return (visibility & (1u << i)) != 0;
+    vec3 light_direction = normalize(hit.position - light.position) * -1.0;
+    float light_distance = length(hit.position - light.position);
+    return is_shadowed(hit, light, light_direction, light_distance);
+}
@@ -0,0 +1,72 @@
+#include "cli.h"
+#include "core/log.h"
+#include "renderer/rutils.h"
+#include <raylib.h>
+#include <stdio.h>
+#include <string.h>
+
+int BVHCommand(int argc, char** argv) {
+    if (argc < 3) {
+        printf("Usage: prism bvh <model.obj> [model.obj ...]\n");
+        return 1;
+    }
+
+    // models can only be loaded with a graphics context
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(1, 1, "Prism");
+
+    int status = 0;
+    for (int i = 2; i < argc; i++) {
+        Model model = LoadModel(argv[i]);
+        if (model.meshCount == 0) {
+            printf("Failed to load model %s\n", argv[i]);
+            status = 1;
+            continue;
+        }
+
+        // gather triangle bounds
+        ARRLIST_TriangleBB geometry = { 0 };
+        for (int m = 0; m < model.meshCount; m++) {
+            Mesh mesh = model.meshes[m];
+            for (int t = 0; t < mesh.vertexCount / 3; t++) {
+                Triangle triangle = { 0 };
+                for (int v = 0; v < 3; v++) {
+                    triangle.a[v] = mesh.vertices[(t * 3 + 0) * 3 + v];
+                    triangle.b[v] = mesh.vertices[(t * 3 + 1) * 3 + v];
+                    triangle.c[v] = mesh.vertices[(t * 3 + 2) * 3 + v];
+                }
+                ARRLIST_TriangleBB_add(&geometry, RUTIL_TriangleBounds(triangle));
+            }
+        }
+        UnloadModel(model);
+
+        // build and report
+        ARRLIST_NodeBVH bvh = { 0 };
+        double start = GetTime();
+        RUTIL_BoundingVolumeHierarchy(&bvh, &geometry);
+        double elapsed = GetTime() - start;
+        BVHReport report = RUTIL_ReportBVH(&bvh, &geometry);
+        printf("%s\n", argv[i]);
+        printf("Build time:           %.3f ms\n", elapsed * 1000.0);
+        RUTIL_PrintBVHReport(&report);
+        printf("\n");
+        if (!report.valid) status = 1;
+
+        ARRLIST_NodeBVH_clear(&bvh);
+        ARRLIST_TriangleBB_clear(&geometry);
+    }
+
+    CloseWindow();
+    return status;
+}
+
+BOOL IsCommand(const char* name) {
+    return strcmp(name, "bvh") == 0;
+}
+
+int RunCommand(int argc, char** argv) {
+    if (strcmp(argv[1], "bvh") == 0) return BVHCommand(argc, argv);
+    LOG_FATAL("Unknown command %s", argv[1]);
+    return 1;
+}
@@ -0,0 +1,10 @@
+#ifndef CLI_H
+#define CLI_H
+
+#include "data/config.h"
+
+BOOL IsCommand(const char* name);
+
+int RunCommand(int argc, char** argv);
+
+#endif
@@ -1,17 +1,17 @@
-#ifndef CONFIG_H
-#define CONFIG_H
-
-#ifndef BOOL
-#define BOOL int
-#endif
-#ifndef TRUE
-#define TRUE 1
-#endif
-#ifndef FALSE
-#define FALSE 0
-#endif
-
-#define EDITOR_DEFAULT_WIDTH 1600
-#define EDITOR_DEFAULT_HEIGHT 900
-
-#endif
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#ifndef BOOL
+#define BOOL int
+#endif
+#ifndef TRUE
+#define TRUE 1
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+#define EDITOR_DEFAULT_WIDTH 1600
+#define EDITOR_DEFAULT_HEIGHT 900
+
+#endif
@@ -1,8 +1,16 @@
 #include "core/editor.h"
+#include "core/cli.h"
 #include "core/log.h"
 #include "renderer/renderer.h"
+#include <string.h>
 
 int main(int argc, char** argv) {
+	if (argc >= 2 && IsCommand(argv[1])) return RunCommand(argc, argv);
+	if (argc >= 2 && strcmp(argv[argc - 1], "--cpu") == 0) {
+		LOG_INFO("Using cpu renderer");
+		OverrideBackend(BACKEND_CPU);
+		argc--;
+	}
 	if (argc == 3) {
 		int rx = atoi(argv[1]);
 		int ry = atoi(argv[2]);
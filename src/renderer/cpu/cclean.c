@@ -0,0 +1,69 @@
+#include "cclean.h"
+#include "renderer/cpu/cupdate.h"
+#include "renderer/cpu/cutils.h"
+#include <easymemory.h>
+
+Renderer* g_cclean_renderer_ref = NULL;
+
+void CCLEAN_Geometry(CPUGeometry* geometry) {
+    CUTIL_DestroyBuffer(&(geometry->triangles));
+    CUTIL_DestroyBuffer(&(geometry->materials));
+    CUTIL_DestroyBuffer(&(geometry->bvh));
+    CUTIL_DestroyBuffer(&(geometry->sdfs));
+    CUTIL_DestroyBuffer(&(geometry->lights));
+}
+
+void CCLEAN_Targets(CPUObject* cpu) {
+    EZFREE(cpu->ages);
+    EZFREE(cpu->output);
+    cpu->ages = NULL;
+    cpu->output = NULL;
+    if (cpu->albedo != NULL) {
+        EZFREE(cpu->albedo);
+        EZFREE(cpu->normals);
+        EZFREE(cpu->filtered[0]);
+        EZFREE(cpu->filtered[1]);
+    }
+    cpu->albedo = NULL;
+    cpu->normals = NULL;
+    cpu->filtered[0] = NULL;
+    cpu->filtered[1] = NULL;
+    g_cclean_renderer_ref->swapchain.reference = NULL;
+}
+
+void CCLEAN_Tiles(CPUTiles* tiles) {
+    if (tiles->order != NULL) EZFREE(tiles->order);
+    tiles->order = NULL;
+    tiles->count = 0;
+}
+
+void CCLEAN_Workers(CPUWorkers* workers) {
+    pthread_mutex_lock(&(workers->lock));
+    workers->running = FALSE;
+    pthread_cond_broadcast(&(workers->wake));
+    pthread_mutex_unlock(&(workers->lock));
+    for (size_t i = 0; i < workers->count; i++) {
+        pthread_join(workers->list[i].thread, NULL);
+        pthread_mutex_destroy(&(workers->list[i].deque.lock));
+        if (workers->list[i].deque.tiles != NULL) EZFREE(workers->list[i].deque.tiles);
+    }
+    pthread_mutex_destroy(&(workers->lock));
+    pthread_cond_destroy(&(workers->wake));
+    pthread_cond_destroy(&(workers->done));
+    pthread_barrier_destroy(&(workers->stage));
+    EZFREE(workers->list);
+    workers->list = NULL;
+    workers->count = 0;
+}
+
+void CCLEAN_CPU(CPUObject* cpu) {
+    CUPDT_Wait(cpu);
+    CCLEAN_Workers(&(cpu->workers));
+    CCLEAN_Tiles(&(cpu->tiles));
+    CCLEAN_Targets(cpu);
+    CCLEAN_Geometry(&(cpu->geometry));
+}
+
+void CCLEAN_SetCPUCleanContext(Renderer* renderer) {
+    g_cclean_renderer_ref = renderer;
+}
@@ -0,0 +1,18 @@
+#ifndef CCLEAN_H
+#define CCLEAN_H
+
+#include "renderer/vulkan/vstructs.h"
+
+void CCLEAN_Geometry(CPUGeometry* geometry);
+
+void CCLEAN_Targets(CPUObject* cpu);
+
+void CCLEAN_Tiles(CPUTiles* tiles);
+
+void CCLEAN_Workers(CPUWorkers* workers);
+
+void CCLEAN_CPU(CPUObject* cpu);
+
+void CCLEAN_SetCPUCleanContext(Renderer* renderer);
+
+#endif
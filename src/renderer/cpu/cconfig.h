@@ -0,0 +1,29 @@
+#ifndef CCONFIG_H
+#define CCONFIG_H
+
+// these mirror the constants in shaders/shader.comp
+#define MAX_RECURSIVE_DEPTH 2000
+#define MAX_BOUNCES 1
+#define EPS 0.0001f
+#define SDF_LIMIT 0.0001f
+
+// these mirror the constants in shaders/denoise.comp
+#define DENOISE_ITERATIONS 4
+#define DENOISE_SIGMA_COLOR 0.6f
+#define DENOISE_SIGMA_NORMAL 64.0f
+#define DENOISE_SIGMA_DEPTH 0.05f
+#define DENOISE_ALBEDO_MIN 0.01f
+
+// these mirror the constants in shaders/sampler.glsl
+#define SAMPLER_GOLDEN 2654435769u
+#define SAMPLER_R2_X 3242174889u
+#define SAMPLER_R2_Y 2447445414u
+
+// widest packet any instruction set can use
+#define CPU_PACKET_MAX_WIDTH 16
+// default edge length of a scheduled tile in pixels
+#define CPU_TILE_SIZE 16
+// packets with this many live lanes or fewer finish a subtree one ray at a time
+#define CPU_PACKET_DIVERGENCE 1
+
+#endif
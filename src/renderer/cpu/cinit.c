@@ -0,0 +1,56 @@
+#include "cinit.h"
+#include "core/log.h"
+#include "renderer/cpu/cupdate.h"
+#include "renderer/cpu/cpacket.h"
+#include "renderer/cpu/cutils.h"
+#include <easymemory.h>
+
+Renderer* g_cinit_renderer_ref = NULL;
+
+BOOL CINIT_Targets(CPUObject* cpu) {
+    size_t pixels = (size_t)g_cinit_renderer_ref->dimensions.x * (size_t)g_cinit_renderer_ref->dimensions.y;
+    cpu->ages = EZALLOC(pixels, sizeof(float));
+    cpu->output = EZALLOC(pixels, 4 * sizeof(uint8_t));
+    if (cpu->ages == NULL || cpu->output == NULL) {
+        LOG_FATAL("Failed to allocate cpu render targets!");
+        return FALSE;
+    }
+    g_cinit_renderer_ref->swapchain.reference = cpu->output;
+    return TRUE;
+}
+
+BOOL CINIT_Workers(CPUObject* cpu) {
+    CPUWorkers* workers = &(cpu->workers);
+    workers->count = CUTIL_CoreCount();
+    workers->list = EZALLOC(workers->count, sizeof(CPUWorker));
+    workers->generation = 0;
+    workers->busy = 0;
+    workers->running = TRUE;
+    pthread_mutex_init(&(workers->lock), NULL);
+    pthread_cond_init(&(workers->wake), NULL);
+    pthread_cond_init(&(workers->done), NULL);
+    pthread_barrier_init(&(workers->stage), NULL, (unsigned)workers->count);
+    for (size_t i = 0; i < workers->count; i++) {
+        workers->list[i].id = i;
+        pthread_mutex_init(&(workers->list[i].deque.lock), NULL);
+    }
+    for (size_t i = 0; i < workers->count; i++) {
+        if (pthread_create(&(workers->list[i].thread), NULL, CUPDT_Worker, &(workers->list[i])) != 0) {
+            LOG_FATAL("Failed to create cpu render worker!");
+            return FALSE;
+        }
+    }
+    LOG_INFO("Started %d cpu render workers", (int)workers->count);
+    return TRUE;
+}
+
+BOOL CINIT_CPU(CPUObject* cpu) {
+    CPACKET_Select();
+    if (!CINIT_Targets(cpu)) return FALSE;
+    if (!CINIT_Workers(cpu)) return FALSE;
+    return TRUE;
+}
+
+void CINIT_SetCPUInitContext(Renderer* renderer) {
+    g_cinit_renderer_ref = renderer;
+}
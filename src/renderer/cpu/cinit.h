@@ -0,0 +1,14 @@
+#ifndef CINIT_H
+#define CINIT_H
+
+#include "renderer/vulkan/vstructs.h"
+
+BOOL CINIT_Targets(CPUObject* cpu);
+
+BOOL CINIT_Workers(CPUObject* cpu);
+
+BOOL CINIT_CPU(CPUObject* cpu);
+
+void CINIT_SetCPUInitContext(Renderer* renderer);
+
+#endif
@@ -0,0 +1,205 @@
+#include "cpacket.h"
+#include "core/log.h"
+#include "renderer/cpu/ctrace.h"
+#include <float.h>
+
+CPUPacketTracer g_cpacket_tracer = CPACKET_RaytraceSSE;
+size_t g_cpacket_width = 4;
+const char* g_cpacket_name = "SSE";
+
+BOOL CPACKET_TraverseSingle(CPUInvocation* invocation, CPURay* ray, uint32_t root, int depth, float* best, uint32_t* triangle) {
+    NodeBVH* bvh = (NodeBVH*)invocation->geometry->bvh.data;
+    uint32_t stack[MAX_RECURSIVE_DEPTH];
+    int stack_ptr = 0;
+    stack[stack_ptr++] = root;
+    while (stack_ptr > 0) {
+        NodeBVH* node = &(bvh[stack[--stack_ptr]]);
+        if (depth + stack_ptr >= MAX_RECURSIVE_DEPTH - 1) return FALSE;
+        if (node->branch_config == BVH_LEAF) {
+            CPUHit trihit;
+            if (CTRACE_TriangleIntersect(invocation, ray, node->left, &trihit)) {
+                if (*best == -1.0f || trihit.distance < *best) {
+                    *best = trihit.distance;
+                    *triangle = node->left;
+                }
+            }
+        } else if (node->branch_config == BVH_LEFT_ONLY) {
+            if (CTRACE_AABBIntersect(invocation, ray, node->left))
+                stack[stack_ptr++] = node->left;
+        } else if (node->branch_config == BVH_RIGHT_ONLY) {
+            if (CTRACE_AABBIntersect(invocation, ray, node->right))
+                stack[stack_ptr++] = node->right;
+        } else {
+            if (CTRACE_AABBIntersect(invocation, ray, node->left))
+                stack[stack_ptr++] = node->left;
+            if (CTRACE_AABBIntersect(invocation, ray, node->right))
+                stack[stack_ptr++] = node->right;
+        }
+    }
+    return TRUE;
+}
+
+// contraction into fma would make packets disagree with the single ray path
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+
+#define PACKET_WIDTH 4
+#define PACKET_SUFFIX SSE
+#include "renderer/cpu/cpacketimpl.h"
+#undef PACKET_SUFFIX
+#undef PACKET_WIDTH
+
+#if defined(__x86_64__) || defined(__i386__)
+#pragma GCC target("avx2")
+#endif
+#define PACKET_WIDTH 8
+#define PACKET_SUFFIX AVX2
+#include "renderer/cpu/cpacketimpl.h"
+#undef PACKET_SUFFIX
+#undef PACKET_WIDTH
+
+#if defined(__x86_64__) || defined(__i386__)
+#pragma GCC target("avx512f")
+#endif
+#define PACKET_WIDTH 16
+#define PACKET_SUFFIX AVX512
+#include "renderer/cpu/cpacketimpl.h"
+#undef PACKET_SUFFIX
+#undef PACKET_WIDTH
+
+#pragma GCC pop_options
+
+void CPACKET_Select() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+#ifndef _WIN32
+    // mingw does not align the stack for wide vectors, so windows stays on sse
+    if (__builtin_cpu_supports("avx512f")) {
+        g_cpacket_tracer = CPACKET_RaytraceAVX512;
+        g_cpacket_width = 16;
+        g_cpacket_name = "AVX-512";
+    } else if (__builtin_cpu_supports("avx2")) {
+        g_cpacket_tracer = CPACKET_RaytraceAVX2;
+        g_cpacket_width = 8;
+        g_cpacket_name = "AVX2";
+    }
+#endif
+#else
+    g_cpacket_name = "generic";
+#endif
+    LOG_INFO("Tracing cpu rays in %s packets of %d", g_cpacket_name, (int)g_cpacket_width);
+}
+
+size_t CPACKET_Width() {
+    return g_cpacket_width;
+}
+
+void CPACKET_Shape(uint32_t* width, uint32_t* height) {
+    // keep packets as square as possible so their rays stay coherent
+    *width = g_cpacket_width >= 8 ? 4 : 2;
+    *height = (uint32_t)g_cpacket_width / *width;
+}
+
+const char* CPACKET_Name() {
+    return g_cpacket_name;
+}
+
+void CPACKET_Raytrace(CPUInvocation* invocation, CPURay* rays, uint32_t active, CPUHit* hits, BOOL* failures) {
+    if (g_cpacket_tracer(invocation, rays, active, hits)) return;
+
+    // the packet stack overflowed, redo each ray alone so failures land on the right pixels
+    for (size_t l = 0; l < g_cpacket_width; l++) {
+        if (!((active >> l) & 1)) continue;
+        invocation->stack_failure = FALSE;
+        hits[l] = CTRACE_Raytrace(invocation, rays[l]);
+        failures[l] |= invocation->stack_failure;
+    }
+}
+
+void CPACKET_Colors(CPUInvocation* invocation, CPURay* rays, uint32_t active, CPUHit* hits, vec3* colors, BOOL* failures) {
+    CPACKET_Raytrace(invocation, rays, active, hits, failures);
+
+    // trace shadow rays per light, they all leave the same light so they stay coherent
+    size_t num_lights = CTRACE_NumLights(invocation);
+    BOOL shadowed[CPU_PACKET_MAX_WIDTH * num_lights];
+    BOOL packed_shadows = invocation->frame->lighting && invocation->frame->shadows;
+    if (packed_shadows) {
+        for (size_t i = 0; i < num_lights; i++) {
+            PointLight light = CTRACE_Light(invocation, i);
+            CPURay shadow_rays[CPU_PACKET_MAX_WIDTH];
+            CPUHit shadow_hits[CPU_PACKET_MAX_WIDTH];
+            float limits[CPU_PACKET_MAX_WIDTH];
+            uint32_t pending = 0;
+            for (size_t l = 0; l < g_cpacket_width; l++) {
+                if (!((active >> l) & 1) || hits[l].distance <= 0.0f) continue;
+                if (CTRACE_ShadowRay(invocation, &(hits[l]), &light, &(shadow_rays[l]), &(limits[l]), &(shadowed[l * num_lights + i])))
+                    pending |= 1u << l;
+            }
+            if (pending == 0) continue;
+            CPACKET_Raytrace(invocation, shadow_rays, pending, shadow_hits, failures);
+            for (size_t l = 0; l < g_cpacket_width; l++) {
+                if (!((pending >> l) & 1)) continue;
+                shadowed[l * num_lights + i] = shadow_hits[l].distance > 0.0f && shadow_hits[l].distance < limits[l];
+            }
+        }
+    }
+
+    // the rest of shading is incoherent, so finish each ray alone
+    for (size_t l = 0; l < g_cpacket_width; l++) {
+        if (!((active >> l) & 1)) continue;
+        invocation->stack_failure = failures[l];
+        CTRACE_HitColor(invocation, &(rays[l]), &(hits[l]), packed_shadows ? &(shadowed[l * num_lights]) : NULL, colors[l]);
+        failures[l] = invocation->stack_failure;
+    }
+}
+
+void CPACKET_Pixels(CPUInvocation* invocation, uint32_t* xs, uint32_t* ys, size_t count) {
+    uint32_t active = 0;
+    int live = 0;
+    for (size_t l = 0; l < count; l++) {
+        if (CTRACE_Select(invocation, xs[l], ys[l])) {
+            active |= 1u << l;
+            live++;
+        }
+    }
+
+    // sdf marching and sparse frameless packets go one ray at a time
+    if (!invocation->frame->raytrace || live <= CPU_PACKET_DIVERGENCE) {
+        for (size_t l = 0; l < count; l++) {
+            if (!((active >> l) & 1)) continue;
+            vec3 color;
+            invocation->stack_failure = FALSE;
+            CTRACE_PixelColor(invocation, xs[l], ys[l], color);
+            CTRACE_Store(invocation, xs[l], ys[l], color);
+        }
+        return;
+    }
+
+    // trace every sample as one packet
+    vec3 colors[CPU_PACKET_MAX_WIDTH] = { 0 };
+    BOOL failures[CPU_PACKET_MAX_WIDTH] = { 0 };
+    float offsets[2] = { -0.5f, 0.5f };
+    int samples = invocation->frame->antialiasing ? 2 : 1;
+    for (int s = 0; s < samples; s++) {
+        float offset = invocation->frame->antialiasing ? offsets[s] : 0.0f;
+        CPURay rays[CPU_PACKET_MAX_WIDTH];
+        CPUHit hits[CPU_PACKET_MAX_WIDTH];
+        vec3 sample_colors[CPU_PACKET_MAX_WIDTH];
+        for (size_t l = 0; l < count; l++) {
+            if (!((active >> l) & 1)) continue;
+            rays[l] = CTRACE_CreateRay(invocation->frame, xs[l] + offset, ys[l] + offset);
+        }
+        CPACKET_Colors(invocation, rays, active, hits, sample_colors, failures);
+        for (size_t l = 0; l < count; l++) {
+            if (!((active >> l) & 1)) continue;
+            glm_vec3_add(colors[l], sample_colors[l], colors[l]);
+            if (s == samples - 1) CTRACE_Surface(invocation, xs[l], ys[l], &(hits[l]));
+        }
+    }
+    for (size_t l = 0; l < count; l++) {
+        if (!((active >> l) & 1)) continue;
+        if (samples > 1) glm_vec3_divs(colors[l], (float)samples, colors[l]);
+        invocation->stack_failure = failures[l];
+        CTRACE_Store(invocation, xs[l], ys[l], colors[l]);
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef CPACKET_H
+#define CPACKET_H
+
+#include "renderer/cpu/cstructs.h"
+
+typedef BOOL (*CPUPacketTracer)(CPUInvocation* invocation, CPURay* rays, uint32_t active, CPUHit* hits);
+
+BOOL CPACKET_TraverseSingle(CPUInvocation* invocation, CPURay* ray, uint32_t root, int depth, float* best, uint32_t* triangle);
+
+BOOL CPACKET_RaytraceSSE(CPUInvocation* invocation, CPURay* rays, uint32_t active, CPUHit* hits);
+
+BOOL CPACKET_RaytraceAVX2(CPUInvocation* invocation, CPURay* rays, uint32_t active, CPUHit* hits);
+
+BOOL CPACKET_RaytraceAVX512(CPUInvocation* invocation, CPURay* rays, uint32_t active, CPUHit* hits);
+
+void CPACKET_Select();
+
+size_t CPACKET_Width();
+
+void CPACKET_Shape(uint32_t* width, uint32_t* height);
+
+const char* CPACKET_Name();
+
+void CPACKET_Raytrace(CPUInvocation* invocation, CPURay* rays, uint32_t active, CPUHit* hits, BOOL* failures);
+
+void CPACKET_Colors(CPUInvocation* invocation, CPURay* rays, uint32_t active, CPUHit* hits, vec3* colors, BOOL* failures);
+
+void CPACKET_Pixels(CPUInvocation* invocation, uint32_t* xs, uint32_t* ys, size_t count);
+
+#endif
@@ -0,0 +1,166 @@
+// packet tracer template, included once per width by cpacket.c
+// expects PACKET_WIDTH and PACKET_SUFFIX to be defined
+
+#define PACKET_CAT2(a, b) a##b
+#define PACKET_CAT(a, b) PACKET_CAT2(a, b)
+#define PACKET_NAME(name) PACKET_CAT(name, PACKET_SUFFIX)
+#define PACKET_FLOAT PACKET_NAME(PacketFloat)
+#define PACKET_INT PACKET_NAME(PacketInt)
+#define PACKET_RAYS PACKET_NAME(PacketRays)
+
+typedef float PACKET_FLOAT __attribute__((vector_size(PACKET_WIDTH * sizeof(float))));
+typedef int32_t PACKET_INT __attribute__((vector_size(PACKET_WIDTH * sizeof(int32_t))));
+
+typedef struct {
+    PACKET_FLOAT origin[3];
+    PACKET_FLOAT direction[3];
+    PACKET_FLOAT inverse[3];
+} PACKET_RAYS;
+
+PACKET_INT PACKET_NAME(PacketMask)(uint32_t bits) {
+    PACKET_INT mask;
+    for (int l = 0; l < PACKET_WIDTH; l++) mask[l] = (bits >> l) & 1 ? -1 : 0;
+    return mask;
+}
+
+uint32_t PACKET_NAME(PacketBits)(PACKET_INT mask) {
+    uint32_t bits = 0;
+    for (int l = 0; l < PACKET_WIDTH; l++) if (mask[l]) bits |= 1u << l;
+    return bits;
+}
+
+PACKET_FLOAT PACKET_NAME(PacketSelect)(PACKET_INT mask, PACKET_FLOAT a, PACKET_FLOAT b) {
+    return (PACKET_FLOAT)((mask & (PACKET_INT)a) | (~mask & (PACKET_INT)b));
+}
+
+PACKET_INT PACKET_NAME(PacketAABB)(PACKET_RAYS* rays, NodeBVH* node, PACKET_INT mask) {
+    PACKET_FLOAT entrance = { 0 };
+    PACKET_FLOAT exit = entrance + FLT_MAX;
+    for (int i = 0; i < 3; i++) {
+        PACKET_FLOAT closest = (node->min[i] - rays->origin[i]) * rays->inverse[i];
+        PACKET_FLOAT farthest = (node->max[i] - rays->origin[i]) * rays->inverse[i];
+        PACKET_INT swap = farthest < closest;
+        PACKET_FLOAT near = PACKET_NAME(PacketSelect)(swap, farthest, closest);
+        PACKET_FLOAT far = PACKET_NAME(PacketSelect)(swap, closest, farthest);
+        mask &= ~((far < entrance) | (near > exit));
+        exit = PACKET_NAME(PacketSelect)(far < exit, far, exit);
+        entrance = PACKET_NAME(PacketSelect)(near > entrance, near, entrance);
+    }
+    return mask;
+}
+
+PACKET_INT PACKET_NAME(PacketTriangle)(PACKET_RAYS* rays, Triangle* tri, PACKET_FLOAT* best, PACKET_INT mask) {
+    // edges and normal are shared by every lane, so do them the scalar way
+    vec3 ab, bc, ca, n;
+    CTRACE_TriangleEdges(tri, ab, bc, ca, n);
+    PACKET_FLOAT* o = rays->origin;
+    PACKET_FLOAT* d = rays->direction;
+    PACKET_FLOAT distance =
+        ((tri->a[0] - o[0]) * n[0] + (tri->a[1] - o[1]) * n[1] + (tri->a[2] - o[2]) * n[2]) /
+        (d[0] * n[0] + d[1] * n[1] + d[2] * n[2]);
+    mask &= distance > 0;
+    PACKET_FLOAT at[3] = {
+        o[0] + d[0] * distance,
+        o[1] + d[1] * distance,
+        o[2] + d[2] * distance };
+    float* verts[3] = { tri->a, tri->b, tri->c };
+    float* edges[3] = { ab, bc, ca };
+    for (int i = 0; i < 3; i++) {
+        PACKET_FLOAT e0 = at[0] - verts[i][0];
+        PACKET_FLOAT e1 = at[1] - verts[i][1];
+        PACKET_FLOAT e2 = at[2] - verts[i][2];
+        PACKET_FLOAT side =
+            (edges[i][1] * e2 - edges[i][2] * e1) * n[0] +
+            (edges[i][2] * e0 - edges[i][0] * e2) * n[1] +
+            (edges[i][0] * e1 - edges[i][1] * e0) * n[2];
+        mask &= side > 0;
+    }
+    mask &= (*best == -1.0f) | (distance < *best);
+    *best = PACKET_NAME(PacketSelect)(mask, distance, *best);
+    return mask;
+}
+
+BOOL PACKET_NAME(CPACKET_Raytrace)(CPUInvocation* invocation, CPURay* rays, uint32_t active, CPUHit* hits) {
+    for (int l = 0; l < PACKET_WIDTH; l++) if ((active >> l) & 1) hits[l].distance = -1.0f;
+    if (invocation->geometry->bvh.size == 0 || active == 0) return TRUE;
+    NodeBVH* bvh = (NodeBVH*)invocation->geometry->bvh.data;
+    Triangle* tris = (Triangle*)invocation->geometry->triangles.data;
+
+    // transpose rays, idle lanes borrow a live ray so they stay finite
+    PACKET_RAYS packet;
+    int live = __builtin_ctz(active);
+    for (int l = 0; l < PACKET_WIDTH; l++) {
+        CPURay* ray = (active >> l) & 1 ? &(rays[l]) : &(rays[live]);
+        for (int i = 0; i < 3; i++) {
+            packet.origin[i][l] = ray->position[i];
+            packet.direction[i][l] = ray->direction[i];
+            packet.inverse[i][l] = 1.0f / ray->direction[i];
+        }
+    }
+
+    // walk the tree in the same order as the single ray path
+    PACKET_FLOAT best = { 0 };
+    best -= 1.0f;
+    uint32_t triangles[PACKET_WIDTH] = { 0 };
+    uint32_t root = PACKET_NAME(PacketBits)(PACKET_NAME(PacketAABB)(&packet, &(bvh[0]), PACKET_NAME(PacketMask)(active)));
+    if (root == 0) return TRUE;
+    uint32_t stack[MAX_RECURSIVE_DEPTH];
+    uint32_t stack_masks[MAX_RECURSIVE_DEPTH];
+    int stack_ptr = 0;
+    stack[stack_ptr] = 0;
+    stack_masks[stack_ptr++] = root;
+    while (stack_ptr > 0) {
+        stack_ptr--;
+        uint32_t node_ind = stack[stack_ptr];
+        uint32_t bits = stack_masks[stack_ptr];
+        NodeBVH* node = &(bvh[node_ind]);
+        if (stack_ptr >= MAX_RECURSIVE_DEPTH - 1) return FALSE;
+
+        // too few lanes left to pay for the packet, finish them one at a time
+        if (__builtin_popcount(bits) <= CPU_PACKET_DIVERGENCE) {
+            for (int l = 0; l < PACKET_WIDTH; l++) {
+                if (!((bits >> l) & 1)) continue;
+                float lane_best = best[l];
+                if (!CPACKET_TraverseSingle(invocation, &(rays[l]), node_ind, stack_ptr, &lane_best, &(triangles[l])))
+                    return FALSE;
+                best[l] = lane_best;
+            }
+            continue;
+        }
+
+        PACKET_INT mask = PACKET_NAME(PacketMask)(bits);
+        if (node->branch_config == BVH_LEAF) {
+            uint32_t closer = PACKET_NAME(PacketBits)(PACKET_NAME(PacketTriangle)(&packet, &(tris[node->left]), &best, mask));
+            for (int l = 0; l < PACKET_WIDTH; l++) if ((closer >> l) & 1) triangles[l] = node->left;
+            continue;
+        }
+        if (node->branch_config != BVH_RIGHT_ONLY) {
+            uint32_t left = PACKET_NAME(PacketBits)(PACKET_NAME(PacketAABB)(&packet, &(bvh[node->left]), mask));
+            if (left != 0) {
+                stack[stack_ptr] = node->left;
+                stack_masks[stack_ptr++] = left;
+            }
+        }
+        if (node->branch_config != BVH_LEFT_ONLY) {
+            uint32_t right = PACKET_NAME(PacketBits)(PACKET_NAME(PacketAABB)(&packet, &(bvh[node->right]), mask));
+            if (right != 0) {
+                stack[stack_ptr] = node->right;
+                stack_masks[stack_ptr++] = right;
+            }
+        }
+    }
+
+    // rebuild full hits from the winning triangles
+    for (int l = 0; l < PACKET_WIDTH; l++) {
+        if (!((active >> l) & 1) || best[l] == -1.0f) continue;
+        CTRACE_TriangleIntersect(invocation, &(rays[l]), triangles[l], &(hits[l]));
+    }
+    return TRUE;
+}
+
+#undef PACKET_RAYS
+#undef PACKET_INT
+#undef PACKET_FLOAT
+#undef PACKET_NAME
+#undef PACKET_CAT
+#undef PACKET_CAT2
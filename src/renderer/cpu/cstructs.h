@@ -0,0 +1,116 @@
+#ifndef CSTRUCTS_H
+#define CSTRUCTS_H
+
+#include "renderer/rstructs.h"
+#include "renderer/cpu/cconfig.h"
+#include <pthread.h>
+
+typedef struct {
+    vec3 position;
+    vec3 direction;
+} CPURay;
+
+typedef struct {
+    float distance;
+    uint32_t material;
+    vec3 normal;
+    vec3 position;
+} CPUHit;
+
+typedef struct {
+    vec3 position;
+    vec3 u;
+    vec3 v;
+    vec3 w;
+    float fov;
+    float width;
+    float height;
+    uint32_t stride;
+    vec2 viewport;
+    float frametime;
+    float frameless;
+    uint32_t sequence;
+    BOOL shadows;
+    BOOL reflections;
+    BOOL lighting;
+    BOOL raytrace;
+    BOOL sdf;
+    float sdfsmooth;
+    uint32_t maxmarches;
+    float time;
+    BOOL antialiasing;
+    BOOL denoise;
+    PixelRegion region;
+} CPUFrame;
+
+typedef struct {
+    void* data;
+    size_t size;
+} CPUDataBuffer;
+
+typedef struct {
+    CPUDataBuffer triangles;
+    CPUDataBuffer materials;
+    CPUDataBuffer bvh;
+    CPUDataBuffer sdfs;
+    CPUDataBuffer lights;
+} CPUGeometry;
+
+typedef struct {
+    uint32_t* tiles;
+    size_t head;
+    size_t tail;
+    pthread_mutex_t lock;
+} CPUDeque;
+
+typedef struct {
+    pthread_t thread;
+    size_t id;
+    CPUDeque deque;
+} CPUWorker;
+
+typedef struct {
+    CPUWorker* list;
+    size_t count;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    pthread_barrier_t stage;
+    uint64_t generation;
+    size_t busy;
+    BOOL running;
+} CPUWorkers;
+
+typedef struct {
+    uint32_t* order;
+    size_t count;
+    uint32_t size;
+    uint32_t columns;
+    uint32_t rows;
+} CPUTiles;
+
+typedef struct {
+    CPUFrame* frame;
+    CPUGeometry* geometry;
+    float* ages;
+    uint8_t* output;
+    float* albedo;
+    float* normals;
+    BOOL stack_failure;
+} CPUInvocation;
+
+typedef struct {
+    CPUFrame frame;
+    CPUGeometry geometry;
+    CPUWorkers workers;
+    CPUTiles tiles;
+    float* ages;
+    uint8_t* output;
+    // denoiser surfaces and ping pong planes, four floats per pixel, allocated on first use
+    float* albedo;
+    float* normals;
+    float* filtered[2];
+    BOOL dispatched;
+} CPUObject;
+
+#endif
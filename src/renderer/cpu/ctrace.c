@@ -0,0 +1,539 @@
+#include "ctrace.h"
+#include <math.h>
+#include <float.h>
+#include <string.h>
+
+#define CTRIANGLES(inv) ((Triangle*)((inv)->geometry->triangles.data))
+#define CMATERIALS(inv) ((SurfaceMaterial*)((inv)->geometry->materials.data))
+#define CBVH(inv) ((NodeBVH*)((inv)->geometry->bvh.data))
+#define CSDFS(inv) ((SDFPrimitive*)((inv)->geometry->sdfs.data))
+#define CLIGHTS(inv) ((PointLight*)((inv)->geometry->lights.data))
+
+float SamplerThreshold(uint32_t x, uint32_t y, uint32_t sequence) {
+    // same r2 dither and golden step as sampler_threshold, wrapping in 32 bits
+    uint32_t bits = x * SAMPLER_R2_X + y * SAMPLER_R2_Y + sequence * SAMPLER_GOLDEN;
+    return (float)(bits >> 8) * (1.0f / 16777216.0f);
+}
+
+BOOL CutViewport(CPUFrame* frame, uint32_t x, uint32_t y) {
+    if (frame->viewport[0] != 0 &&
+        (x < ceilf((frame->width - frame->viewport[0]) / 2.0f) ||
+        (x > ceilf((frame->width + frame->viewport[0]) / 2.0f)))) return TRUE;
+    if (frame->viewport[1] != 0 &&
+        (y < ceilf((frame->height - frame->viewport[1]) / 2.0f) ||
+        (y > ceilf((frame->height + frame->viewport[1]) / 2.0f)))) return TRUE;
+    return FALSE;
+}
+
+CPURay CTRACE_CreateRay(CPUFrame* frame, float x, float y) {
+    float r = frame->width / 2.0f;
+    float b = frame->height / 2.0f;
+    float l = -1.0f * r;
+    float t = -1.0f * b;
+    float u = l + ((r - l) * (x + 0.5f)) / frame->width;
+    float v = b + ((t - b) * (y + 0.5f)) / frame->height;
+    float d = (cosf(frame->fov / 2.0f) / sinf(frame->fov / 2.0f)) * r;
+    CPURay ray;
+    glm_vec3_scale(frame->u, u, ray.direction);
+    glm_vec3_muladds(frame->v, v, ray.direction);
+    glm_vec3_muladds(frame->w, -d, ray.direction);
+    glm_vec3_normalize(ray.direction);
+    glm_vec3_copy(frame->position, ray.position);
+    return ray;
+}
+
+void CTRACE_TriangleEdges(Triangle* tri, vec3 ab, vec3 bc, vec3 ca, vec3 normal) {
+    glm_vec3_sub(tri->b, tri->a, ab);
+    glm_vec3_sub(tri->c, tri->b, bc);
+    glm_vec3_sub(tri->a, tri->c, ca);
+    glm_vec3_cross(ab, bc, normal);
+    glm_vec3_normalize(normal);
+}
+
+BOOL CTRACE_TriangleIntersect(CPUInvocation* invocation, CPURay* ray, uint32_t triangle_ind, CPUHit* hit) {
+    Triangle* tri = &(CTRIANGLES(invocation)[triangle_ind]);
+    vec3 ab, bc, ca, offset;
+    CTRACE_TriangleEdges(tri, ab, bc, ca, hit->normal);
+    glm_vec3_sub(tri->a, ray->position, offset);
+    hit->distance = glm_vec3_dot(offset, hit->normal) / glm_vec3_dot(ray->direction, hit->normal);
+    if (hit->distance > 0) {
+        vec3 hit_at, edge, cross;
+        glm_vec3_copy(ray->position, hit_at);
+        glm_vec3_muladds(ray->direction, hit->distance, hit_at);
+        glm_vec3_sub(hit_at, tri->a, edge);
+        glm_vec3_cross(ab, edge, cross);
+        float da = glm_vec3_dot(cross, hit->normal);
+        glm_vec3_sub(hit_at, tri->b, edge);
+        glm_vec3_cross(bc, edge, cross);
+        float db = glm_vec3_dot(cross, hit->normal);
+        glm_vec3_sub(hit_at, tri->c, edge);
+        glm_vec3_cross(ca, edge, cross);
+        float dc = glm_vec3_dot(cross, hit->normal);
+        if (da > 0 && db > 0 && dc > 0) {
+            hit->material = tri->material;
+            glm_vec3_copy(hit_at, hit->position);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+BOOL CTRACE_AABBIntersect(CPUInvocation* invocation, CPURay* ray, uint32_t node_ind) {
+    NodeBVH* node = &(CBVH(invocation)[node_ind]);
+    float entrance = 0.0f;
+    float exit = FLT_MAX;
+    for (int i = 0; i < 3; i++) {
+        float inv_dir = 1.0f / ray->direction[i];
+        float closest = (node->min[i] - ray->position[i]) * inv_dir;
+        float farthest = (node->max[i] - ray->position[i]) * inv_dir;
+        if (farthest < closest) {
+            float temp = farthest;
+            farthest = closest;
+            closest = temp;
+        }
+        if (farthest < entrance || closest > exit) return FALSE;
+        exit = farthest < exit ? farthest : exit;
+        entrance = closest > entrance ? closest : entrance;
+    }
+    return TRUE;
+}
+
+CPUHit CTRACE_Raytrace(CPUInvocation* invocation, CPURay ray) {
+    CPUHit hit = { 0 };
+    hit.distance = -1.0f;
+    if (invocation->geometry->bvh.size == 0) return hit;
+    if (!CTRACE_AABBIntersect(invocation, &ray, 0)) return hit;
+    uint32_t stack[MAX_RECURSIVE_DEPTH];
+    int stack_ptr = 0;
+    stack[stack_ptr++] = 0;
+    while (stack_ptr > 0) {
+        NodeBVH* node = &(CBVH(invocation)[stack[--stack_ptr]]);
+        if (stack_ptr >= MAX_RECURSIVE_DEPTH - 1) {
+            invocation->stack_failure = TRUE;
+            break;
+        }
+        if (node->branch_config == BVH_LEAF) {
+            CPUHit trihit;
+            if (CTRACE_TriangleIntersect(invocation, &ray, node->left, &trihit)) {
+                if (hit.distance == -1.0f || trihit.distance < hit.distance) {
+                    hit = trihit;
+                }
+            }
+        } else if (node->branch_config == BVH_LEFT_ONLY) {
+            if (CTRACE_AABBIntersect(invocation, &ray, node->left))
+                stack[stack_ptr++] = node->left;
+        } else if (node->branch_config == BVH_RIGHT_ONLY) {
+            if (CTRACE_AABBIntersect(invocation, &ray, node->right))
+                stack[stack_ptr++] = node->right;
+        } else {
+            if (CTRACE_AABBIntersect(invocation, &ray, node->left))
+                stack[stack_ptr++] = node->left;
+            if (CTRACE_AABBIntersect(invocation, &ray, node->right))
+                stack[stack_ptr++] = node->right;
+        }
+    }
+    return hit;
+}
+
+float CTRACE_LightDirection(CPUHit* hit, PointLight* light, vec3 light_direction) {
+    glm_vec3_sub(hit->position, light->position, light_direction);
+    float light_distance = glm_vec3_norm(light_direction);
+    glm_vec3_normalize(light_direction);
+    glm_vec3_negate(light_direction);
+    return light_distance;
+}
+
+BOOL CTRACE_ShadowRay(CPUInvocation* invocation, CPUHit* hit, PointLight* light, CPURay* ray, float* limit, BOOL* shadowed) {
+    *shadowed = FALSE;
+    if (hit->distance < 0.0f || !invocation->frame->shadows) return FALSE;
+    vec3 light_direction;
+    float light_distance = CTRACE_LightDirection(hit, light, light_direction);
+    if (glm_vec3_dot(hit->normal, light_direction) < 0.0f) {
+        *shadowed = TRUE;
+        return FALSE;
+    }
+    glm_vec3_copy(light->position, ray->position);
+    glm_vec3_negate_to(light_direction, ray->direction);
+    *limit = light_distance - EPS;
+    return TRUE;
+}
+
+BOOL IsShadowed(CPUInvocation* invocation, CPUHit* hit, PointLight* light) {
+    CPURay ray;
+    float limit;
+    BOOL shadowed;
+    if (!CTRACE_ShadowRay(invocation, hit, light, &ray, &limit, &shadowed)) return shadowed;
+    CPUHit shit = CTRACE_Raytrace(invocation, ray);
+    return shit.distance > 0.0f && shit.distance < limit;
+}
+
+void DShade(CPUHit* hit, vec3 color) {
+    vec3 dif_dir = { 0.7f, 0.6f, 0.4f };
+    vec3 amb_dir = { 0.0f, 0.8f, 0.6f };
+    float dif = glm_clamp(glm_vec3_dot(hit->normal, dif_dir), 0.0f, 1.0f);
+    float amb = 0.5f + 0.5f * glm_vec3_dot(hit->normal, amb_dir);
+    color[0] = sqrtf(0.2f * amb + 0.8f * dif);
+    color[1] = sqrtf(0.3f * amb + 0.7f * dif);
+    color[2] = sqrtf(0.4f * amb + 0.5f * dif);
+}
+
+void Shade(CPUInvocation* invocation, CPURay* ray, CPUHit* hit, PointLight* light, BOOL* shadowed_hint, vec3 color) {
+    glm_vec3_abs(ray->direction, color);
+    if (hit->distance > 0) {
+        // calculate light stuff
+        vec3 light_direction;
+        CTRACE_LightDirection(hit, light, light_direction);
+
+        // shadows, possibly already traced as a packet
+        BOOL shadowed = shadowed_hint != NULL ? *shadowed_hint : IsShadowed(invocation, hit, light);
+
+        // material
+        SurfaceMaterial* material = &(CMATERIALS(invocation)[hit->material]);
+
+        // ambient light
+        glm_vec3_mul(material->ambient, light->ambient, color);
+
+        // diffuse light
+        vec3 term;
+        if (!shadowed) {
+            glm_vec3_mul(material->diffuse, light->diffuse, term);
+            glm_vec3_muladds(term, glm_vec3_dot(light_direction, hit->normal), color);
+        }
+
+        // specular light
+        vec3 reflection;
+        glm_vec3_reflect(light_direction, hit->normal, reflection);
+        glm_vec3_normalize(reflection);
+        float specular_const = glm_vec3_dot(reflection, ray->direction);
+        if (specular_const >= 0 && !shadowed) {
+            glm_vec3_mul(light->specular, material->specular, term);
+            glm_vec3_muladds(term, powf(specular_const, material->shiny), color);
+        }
+
+        // divide to ensure not above 1, 1, 1
+        glm_vec3_divs(color, 3.0f, color);
+    }
+}
+
+size_t CTRACE_NumLights(CPUInvocation* invocation) {
+    return invocation->geometry->lights.size > 0 ? invocation->geometry->lights.size : 1;
+}
+
+PointLight CTRACE_Light(CPUInvocation* invocation, size_t index) {
+    if (invocation->geometry->lights.size > 0) return CLIGHTS(invocation)[index];
+    PointLight light = { 0 };
+    glm_vec3_copy(invocation->frame->position, light.position);
+    glm_vec3_one(light.ambient);
+    glm_vec3_one(light.diffuse);
+    glm_vec3_one(light.specular);
+    return light;
+}
+
+void ShadeLights(CPUInvocation* invocation, CPURay* ray, CPUHit* hit, BOOL* shadowed, vec3 color) {
+    size_t num_lights = CTRACE_NumLights(invocation);
+    glm_vec3_zero(color);
+    for (size_t i = 0; i < num_lights; i++) {
+        PointLight light = CTRACE_Light(invocation, i);
+        vec3 shaded;
+        Shade(invocation, ray, hit, &light, shadowed != NULL ? &(shadowed[i]) : NULL, shaded);
+        glm_vec3_add(color, shaded, color);
+    }
+}
+
+void DrawLight(CPURay* ray, CPUHit* hit, PointLight* light, vec3 color) {
+    float light_radius = 1.0f;
+    vec3 l_t, offset;
+    glm_vec3_sub(light->position, ray->position, offset);
+    glm_vec3_copy(ray->position, l_t);
+    glm_vec3_muladds(ray->direction, glm_vec3_dot(offset, ray->direction), l_t);
+    float l_d = glm_vec3_distance(l_t, light->position);
+    vec3 light_color;
+    glm_vec3_add(light->ambient, light->diffuse, light_color);
+    glm_vec3_add(light_color, light->specular, light_color);
+    glm_vec3_divs(light_color, 3.0f, light_color);
+    if (!glm_vec3_eqv(l_t, ray->position) &&
+        (hit->distance <= 0 || glm_vec3_distance(l_t, ray->position) < hit->distance) &&
+        l_d < light_radius) {
+        float brilliance = 1.0f - (l_d / light_radius);
+        glm_vec3_mix(color, light_color, powf(brilliance, 5), color);
+    }
+}
+
+void ReflectColor(CPUInvocation* invocation, CPURay* ray, CPUHit* hit, int bounces, vec3 color) {
+    if (hit->distance < 0.0f) return;
+    SurfaceMaterial* material = &(CMATERIALS(invocation)[hit->material]);
+    if (material->reflect <= 0.0f) return;
+    vec3 colors[MAX_BOUNCES] = { 0 };
+    float reflectionvals[MAX_BOUNCES] = { 0 };
+    int num_colors = 0;
+    CPUHit rhit = *hit;
+    CPURay rray = *ray;
+    for (int i = 0; i < bounces; i++) {
+        glm_vec3_reflect(rray.direction, rhit.normal, rray.direction);
+        glm_vec3_copy(rhit.position, rray.position);
+        glm_vec3_muladds(rray.direction, EPS, rray.position);
+        rhit = CTRACE_Raytrace(invocation, rray);
+        glm_vec3_copy(invocation->frame->position, rhit.position);
+        glm_vec3_muladds(rray.direction, rhit.distance, rhit.position);
+        reflectionvals[num_colors] = material->reflect;
+        glm_vec3_abs(rray.direction, colors[num_colors]);
+        if (rhit.distance >= 0.0f) ShadeLights(invocation, ray, &rhit, NULL, colors[num_colors]);
+        num_colors++;
+        if (rhit.distance <= 0.0f || CMATERIALS(invocation)[rhit.material].reflect <= 0.0f) break;
+        material = &(CMATERIALS(invocation)[rhit.material]);
+    }
+    // fold deepest bounce back towards the camera
+    for (int i = num_colors - 1; i >= 0; i--) {
+        float* under = i == 0 ? color : colors[i - 1];
+        glm_vec3_mix(under, colors[i], reflectionvals[i], under);
+    }
+}
+
+float SDFSphere(SDFPrimitive* sphere, vec3 position) {
+    return glm_vec3_distance(sphere->origin, position) - sphere->scale;
+}
+
+void QSqr(vec4 a, vec4 dest) {
+    vec4 result = {
+        a[0] * a[0] - a[1] * a[1] - a[2] * a[2] - a[3] * a[3],
+        2.0f * a[0] * a[1],
+        2.0f * a[0] * a[2],
+        2.0f * a[0] * a[3] };
+    glm_vec4_copy(result, dest);
+}
+
+float SDFJulia(CPUInvocation* invocation, SDFPrimitive* julia, vec3 position) {
+    float time = invocation->frame->time;
+    vec4 c = {
+        0.45f * cosf(0.5f + time * 0.15f * 1.2f) - 0.3f,
+        0.45f * cosf(3.9f + time * 0.15f * 1.7f),
+        0.45f * cosf(1.4f + time * 0.15f * 1.3f),
+        0.45f * cosf(1.1f + time * 0.15f * 2.5f) };
+    vec4 z = { position[0], position[1], position[2], 0.0f };
+    float md2 = 1.0f;
+    float mz2 = glm_vec4_dot(z, z);
+    for (int i = 0; i < 11; i++) {
+        md2 *= 4.0f * mz2;
+        QSqr(z, z);
+        glm_vec4_add(z, c, z);
+        mz2 = glm_vec4_dot(z, z);
+        if (mz2 > 4.0f) break;
+    }
+    return 0.25f * sqrtf(mz2 / md2) * logf(mz2);
+}
+
+float SDFMandelbulb(CPUInvocation* invocation, SDFPrimitive* bulb, vec3 position) {
+    float power = invocation->frame->time;
+    float dr = 1.0f;
+    float r = 0.0f;
+    vec3 z;
+    glm_vec3_copy(position, z);
+    for (int i = 0; i < 15; i++) {
+        r = glm_vec3_norm(z);
+        if (r > 2.0f)
+            break;
+        float theta = acosf(z[2] / r);
+        float phi = atan2f(z[1], z[0]);
+        dr = powf(r, power - 1.0f) * power * dr + 1.0f;
+
+        float zr = powf(r, power);
+        theta = theta * power;
+        phi = phi * power;
+
+        z[0] = zr * sinf(theta) * cosf(phi);
+        z[1] = zr * sinf(phi) * sinf(theta);
+        z[2] = zr * cosf(theta);
+        glm_vec3_add(z, position, z);
+    }
+    return 0.5f * logf(r) * r / dr;
+}
+
+float SDFBox(SDFPrimitive* box, vec3 position) {
+    vec3 q, clamped;
+    glm_vec3_sub(box->origin, position, q);
+    glm_vec3_abs(q, q);
+    glm_vec3_sub(q, box->dim, q);
+    glm_vec3_maxv(q, GLM_VEC3_ZERO, clamped);
+    return glm_vec3_norm(clamped) + glm_min(glm_max(q[0], glm_max(q[1], q[2])), 0.0f);
+}
+
+float SMin(float a, float b, float k) {
+    float r = exp2f(-a / k) + exp2f(-b / k);
+    return -k * log2f(r);
+}
+
+float SDF(CPUInvocation* invocation, vec3 position) {
+    float distance = 0.0f;
+    BOOL dinit = FALSE;
+    for (size_t i = 0; i < invocation->geometry->sdfs.size; i++) {
+        SDFPrimitive* prim = &(CSDFS(invocation)[i]);
+        float curr_dist = 0.0f;
+        if (prim->type == SDF_SPHERE) {
+            curr_dist = SDFSphere(prim, position);
+        } else if (prim->type == SDF_JULIA) {
+            curr_dist = SDFJulia(invocation, prim, position);
+        } else if (prim->type == SDF_MANDELBULB) {
+            curr_dist = SDFMandelbulb(invocation, prim, position);
+        } else if (prim->type == SDF_BOX) {
+            curr_dist = SDFBox(prim, position);
+        }
+        if (!dinit) {
+            dinit = TRUE;
+            distance = curr_dist;
+            continue;
+        }
+        if (invocation->frame->sdfsmooth == 0.0f)
+            distance = glm_min(curr_dist, distance);
+        else
+            distance = SMin(curr_dist, distance, invocation->frame->sdfsmooth);
+    }
+    return distance;
+}
+
+void SDFNormal(CPUInvocation* invocation, vec3 position, vec3 normal) {
+    vec3 offsets[4] = {
+        { 1.0f, -1.0f, -1.0f },
+        { -1.0f, -1.0f, 1.0f },
+        { -1.0f, 1.0f, -1.0f },
+        { 1.0f, 1.0f, 1.0f } };
+    glm_vec3_zero(normal);
+    for (int i = 0; i < 4; i++) {
+        vec3 sample;
+        glm_vec3_copy(position, sample);
+        glm_vec3_muladds(offsets[i], EPS, sample);
+        glm_vec3_muladds(offsets[i], SDF(invocation, sample), normal);
+    }
+    glm_vec3_normalize(normal);
+}
+
+CPUHit Raymarch(CPUInvocation* invocation, CPURay ray) {
+    CPUHit hit = { 0 };
+    hit.distance = -1.0f;
+    glm_vec3_copy(ray.position, hit.position);
+    for (uint32_t i = 0; i < invocation->frame->maxmarches; i++) {
+        float curr_march = SDF(invocation, ray.position);
+        if (curr_march <= SDF_LIMIT) {
+            hit.distance = glm_vec3_distance(ray.position, hit.position);
+            glm_vec3_copy(ray.position, hit.position);
+            SDFNormal(invocation, ray.position, hit.normal);
+            return hit;
+        }
+        glm_vec3_muladds(ray.direction, curr_march, ray.position);
+    }
+    return hit;
+}
+
+CPUHit CTRACE_Trace(CPUInvocation* invocation, CPURay ray) {
+    CPUHit hit = { 0 };
+    hit.distance = -1.0f;
+    if (invocation->frame->raytrace) {
+        hit = CTRACE_Raytrace(invocation, ray);
+    } else if (invocation->frame->sdf) {
+        hit = Raymarch(invocation, ray);
+    }
+    return hit;
+}
+
+void CTRACE_HitColor(CPUInvocation* invocation, CPURay* ray, CPUHit* hit, BOOL* shadowed, vec3 color) {
+    // colors
+    glm_vec3_abs(ray->direction, color);
+
+    // shade
+    if (invocation->frame->raytrace) {
+        if (hit->distance > 0.0f) {
+            if (invocation->frame->lighting) {
+                ShadeLights(invocation, ray, hit, shadowed, color);
+            } else {
+                DShade(hit, color);
+            }
+            if (invocation->frame->reflections) ReflectColor(invocation, ray, hit, MAX_BOUNCES, color);
+        }
+    } else if (invocation->frame->sdf) {
+        if (hit->distance > 0.0f) {
+            DShade(hit, color);
+        }
+    }
+    for (size_t i = 0; i < invocation->geometry->lights.size; i++)
+        DrawLight(ray, hit, &(CLIGHTS(invocation)[i]), color);
+}
+
+void CTRACE_RayColor(CPUInvocation* invocation, float x, float y, CPUHit* hit, vec3 color) {
+    CPURay ray = CTRACE_CreateRay(invocation->frame, x, y);
+    *hit = CTRACE_Trace(invocation, ray);
+    CTRACE_HitColor(invocation, &ray, hit, NULL, color);
+}
+
+void CTRACE_Surface(CPUInvocation* invocation, uint32_t x, uint32_t y, CPUHit* hit) {
+    if (!invocation->frame->denoise || invocation->albedo == NULL) return;
+    size_t ind = (y * (size_t)invocation->frame->stride + x) * 4;
+
+    // same edge stops the gpu writes, the sky keeps a white albedo and negative depth
+    BOOL surface = hit->distance > 0.0f;
+    glm_vec3_copy((vec3){ 1.0f, 1.0f, 1.0f }, &(invocation->albedo[ind]));
+    if (surface && invocation->frame->raytrace)
+        glm_vec3_copy(CMATERIALS(invocation)[hit->material].diffuse, &(invocation->albedo[ind]));
+    if (surface) {
+        glm_vec3_copy(hit->normal, &(invocation->normals[ind]));
+    } else {
+        glm_vec3_zero(&(invocation->normals[ind]));
+    }
+    invocation->normals[ind + 3] = surface ? hit->distance : -1.0f;
+}
+
+BOOL CTRACE_Select(CPUInvocation* invocation, uint32_t x, uint32_t y) {
+    CPUFrame* frame = invocation->frame;
+    size_t ind = y * (size_t)frame->stride + x;
+
+    // update ray history
+    invocation->ages[ind] += frame->frametime;
+
+    // calculate frame chance
+    float chance = 1.0f - powf(1.0f - frame->frameless, invocation->ages[ind]);
+    if (SamplerThreshold(x, y, frame->sequence) >= chance) {
+        memset(&(invocation->output[ind * 4]), 0, 4);
+        return FALSE;
+    }
+
+    // clear ray history
+    invocation->ages[ind] = 0.0f;
+
+    // reject any rays outside of the viewport
+    return !CutViewport(frame, x, y);
+}
+
+void CTRACE_Store(CPUInvocation* invocation, uint32_t x, uint32_t y, vec3 color) {
+    CPUFrame* frame = invocation->frame;
+    uint8_t* output = &(invocation->output[(y * (size_t)frame->stride + x) * 4]);
+
+    // failures
+    if (invocation->stack_failure) glm_vec3_copy((vec3){ 1.0f, 0.0f, 0.0f }, color);
+
+    // write to image the same way a unorm storage image would
+    for (int i = 0; i < 3; i++)
+        output[i] = (uint8_t)(glm_clamp(color[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+    output[3] = frame->frameless < 1.0f ? 26 : 255;
+}
+
+void CTRACE_PixelColor(CPUInvocation* invocation, uint32_t x, uint32_t y, vec3 color) {
+    CPUHit hit;
+    if (!invocation->frame->antialiasing) {
+        CTRACE_RayColor(invocation, x, y, &hit, color);
+    } else {
+        vec3 sample;
+        glm_vec3_zero(color);
+        CTRACE_RayColor(invocation, x - 0.5f, y - 0.5f, &hit, sample);
+        glm_vec3_add(color, sample, color);
+        CTRACE_RayColor(invocation, x + 0.5f, y + 0.5f, &hit, sample);
+        glm_vec3_add(color, sample, color);
+        glm_vec3_divs(color, 2.0f, color);
+    }
+    CTRACE_Surface(invocation, x, y, &hit);
+}
+
+void CTRACE_Pixel(CPUInvocation* invocation, uint32_t x, uint32_t y) {
+    if (!CTRACE_Select(invocation, x, y)) return;
+    vec3 color;
+    invocation->stack_failure = FALSE;
+    CTRACE_PixelColor(invocation, x, y, color);
+    CTRACE_Store(invocation, x, y, color);
+}
@@ -0,0 +1,40 @@
+#ifndef CTRACE_H
+#define CTRACE_H
+
+#include "renderer/cpu/cstructs.h"
+
+CPURay CTRACE_CreateRay(CPUFrame* frame, float x, float y);
+
+void CTRACE_TriangleEdges(Triangle* tri, vec3 ab, vec3 bc, vec3 ca, vec3 normal);
+
+BOOL CTRACE_TriangleIntersect(CPUInvocation* invocation, CPURay* ray, uint32_t triangle_ind, CPUHit* hit);
+
+BOOL CTRACE_AABBIntersect(CPUInvocation* invocation, CPURay* ray, uint32_t node_ind);
+
+CPUHit CTRACE_Raytrace(CPUInvocation* invocation, CPURay ray);
+
+float CTRACE_LightDirection(CPUHit* hit, PointLight* light, vec3 light_direction);
+
+BOOL CTRACE_ShadowRay(CPUInvocation* invocation, CPUHit* hit, PointLight* light, CPURay* ray, float* limit, BOOL* shadowed);
+
+size_t CTRACE_NumLights(CPUInvocation* invocation);
+
+PointLight CTRACE_Light(CPUInvocation* invocation, size_t index);
+
+CPUHit CTRACE_Trace(CPUInvocation* invocation, CPURay ray);
+
+void CTRACE_HitColor(CPUInvocation* invocation, CPURay* ray, CPUHit* hit, BOOL* shadowed, vec3 color);
+
+void CTRACE_RayColor(CPUInvocation* invocation, float x, float y, CPUHit* hit, vec3 color);
+
+void CTRACE_Surface(CPUInvocation* invocation, uint32_t x, uint32_t y, CPUHit* hit);
+
+BOOL CTRACE_Select(CPUInvocation* invocation, uint32_t x, uint32_t y);
+
+void CTRACE_Store(CPUInvocation* invocation, uint32_t x, uint32_t y, vec3 color);
+
+void CTRACE_PixelColor(CPUInvocation* invocation, uint32_t x, uint32_t y, vec3 color);
+
+void CTRACE_Pixel(CPUInvocation* invocation, uint32_t x, uint32_t y);
+
+#endif
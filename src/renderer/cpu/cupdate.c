@@ -0,0 +1,348 @@
+#include "cupdate.h"
+#include "renderer/cpu/cpacket.h"
+#include "renderer/cpu/cutils.h"
+#include "renderer/rutils.h"
+#include "renderer/renderer.h"
+#include <easymemory.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+Renderer* g_cupdt_renderer_ref = NULL;
+
+void CUPDT_Geometry(CPUGeometry* geometry) {
+    ChangeSet* changes = &(g_cupdt_renderer_ref->geometry.changes);
+
+    // workers are idle here, so the snapshot can be swapped out freely
+    if (changes->update_triangles) {
+        changes->update_triangles = FALSE;
+        CUTIL_CopyToBuffer(
+            g_cupdt_renderer_ref->geometry.triangles.data,
+            g_cupdt_renderer_ref->geometry.triangles.size,
+            sizeof(Triangle), &(geometry->triangles));
+        RUTIL_BoundingVolumeHierarchy(&g_cupdt_renderer_ref->geometry.bvh, &g_cupdt_renderer_ref->geometry.tbbs);
+        CUTIL_CopyToBuffer(
+            g_cupdt_renderer_ref->geometry.bvh.data,
+            g_cupdt_renderer_ref->geometry.bvh.size,
+            sizeof(NodeBVH), &(geometry->bvh));
+    }
+    if (changes->update_sdfs) {
+        changes->update_sdfs = FALSE;
+        CUTIL_CopyToBuffer(
+            g_cupdt_renderer_ref->geometry.sdfs.data,
+            g_cupdt_renderer_ref->geometry.sdfs.size,
+            sizeof(SDFPrimitive), &(geometry->sdfs));
+    }
+    if (changes->update_materials) {
+        changes->update_materials = FALSE;
+        CUTIL_CopyToBuffer(
+            g_cupdt_renderer_ref->geometry.materials.data,
+            g_cupdt_renderer_ref->geometry.materials.size,
+            sizeof(SurfaceMaterial), &(geometry->materials));
+    }
+    if (changes->update_lights) {
+        changes->update_lights = FALSE;
+        CUTIL_CopyToBuffer(
+            g_cupdt_renderer_ref->geometry.lights.data,
+            g_cupdt_renderer_ref->geometry.lights.size,
+            sizeof(PointLight), &(geometry->lights));
+    }
+}
+
+void CUPDT_Frame(CPUFrame* frame) {
+    #define RAYVEC_TO_GLMVEC(gv, rv) { gv[0] = rv.x; gv[1] = rv.y; gv[2] = rv.z; }
+    vec3 look, up;
+    RAYVEC_TO_GLMVEC(frame->position, g_cupdt_renderer_ref->camera.position);
+    RAYVEC_TO_GLMVEC(look, g_cupdt_renderer_ref->camera.look);
+    glm_vec3_sub(look, frame->position, look);
+    RAYVEC_TO_GLMVEC(up, g_cupdt_renderer_ref->camera.up);
+    glm_vec3_normalize(up);
+    glm_vec3_normalize(look);
+    glm_vec3_negate_to(look, frame->w);
+    glm_vec3_crossn(up, frame->w, frame->u);
+    glm_vec3_crossn(frame->w, frame->u, frame->v);
+    frame->fov = glm_rad(g_cupdt_renderer_ref->camera.fov);
+    frame->width = g_cupdt_renderer_ref->extent.x;
+    frame->height = g_cupdt_renderer_ref->extent.y;
+    frame->stride = (uint32_t)g_cupdt_renderer_ref->dimensions.x;
+    frame->viewport[0] = g_cupdt_renderer_ref->viewport.x;
+    frame->viewport[1] = g_cupdt_renderer_ref->viewport.y;
+    frame->frametime = RenderFrameTime();
+    frame->frameless = g_cupdt_renderer_ref->config.frameless;
+    frame->sequence++;
+    frame->shadows = g_cupdt_renderer_ref->config.shadows;
+    frame->reflections = g_cupdt_renderer_ref->config.reflections;
+    frame->lighting = g_cupdt_renderer_ref->config.lighting;
+    frame->raytrace = g_cupdt_renderer_ref->config.raytrace;
+    frame->sdf = g_cupdt_renderer_ref->config.sdf;
+    frame->sdfsmooth = g_cupdt_renderer_ref->config.sdfsmooth;
+    frame->maxmarches = g_cupdt_renderer_ref->config.maxmarches;
+    frame->time = g_cupdt_renderer_ref->config.time;
+    frame->antialiasing = g_cupdt_renderer_ref->config.antialiasing;
+    frame->denoise = g_cupdt_renderer_ref->config.denoise;
+    frame->region = g_cupdt_renderer_ref->region;
+    #undef RAYVEC_TO_GLMVEC
+}
+
+uint32_t CompactMorton(uint32_t code) {
+    code &= 0x55555555;
+    code = (code | (code >> 1)) & 0x33333333;
+    code = (code | (code >> 2)) & 0x0f0f0f0f;
+    code = (code | (code >> 4)) & 0x00ff00ff;
+    code = (code | (code >> 8)) & 0x0000ffff;
+    return code;
+}
+
+void CUPDT_Extent(CPUObject* cpu) {
+    // buffers stay allocated at full size, a new extent only ages every pixel out
+    if (cpu->frame.width == g_cupdt_renderer_ref->extent.x && cpu->frame.height == g_cupdt_renderer_ref->extent.y) return;
+    size_t pixels = (size_t)g_cupdt_renderer_ref->dimensions.x * (size_t)g_cupdt_renderer_ref->dimensions.y;
+    for (size_t i = 0; i < pixels; i++) cpu->ages[i] = RETRACE_AGE;
+}
+
+void CUPDT_Tiles(CPUObject* cpu) {
+    CPUTiles* tiles = &(cpu->tiles);
+    uint32_t size = g_cupdt_renderer_ref->config.tilesize > 0 ? g_cupdt_renderer_ref->config.tilesize : 1;
+    uint32_t columns = ((uint32_t)cpu->frame.width + size - 1) / size;
+    uint32_t rows = ((uint32_t)cpu->frame.height + size - 1) / size;
+    if (tiles->order != NULL && tiles->size == size && tiles->columns == columns && tiles->rows == rows) return;
+    tiles->size = size;
+    tiles->columns = columns;
+    tiles->rows = rows;
+    tiles->count = (size_t)columns * rows;
+
+    // walk the enclosing power of two square in morton order and keep tiles inside the image
+    uint32_t side = 1;
+    while (side < columns || side < rows) side <<= 1;
+    if (tiles->order != NULL) EZFREE(tiles->order);
+    tiles->order = EZALLOC(tiles->count, sizeof(uint32_t));
+    size_t ind = 0;
+    for (uint64_t code = 0; code < (uint64_t)side * side; code++) {
+        uint32_t x = CompactMorton((uint32_t)code);
+        uint32_t y = CompactMorton((uint32_t)(code >> 1));
+        if (x < columns && y < rows) tiles->order[ind++] = y * columns + x;
+    }
+
+    // any worker may end up holding every tile
+    for (size_t i = 0; i < cpu->workers.count; i++) {
+        CPUDeque* deque = &(cpu->workers.list[i].deque);
+        if (deque->tiles != NULL) EZFREE(deque->tiles);
+        deque->tiles = EZALLOC(tiles->count, sizeof(uint32_t));
+    }
+}
+
+void CUPDT_Tile(CPUObject* cpu, CPUInvocation* invocation, uint32_t tile) {
+    uint32_t packet_w, packet_h;
+    CPACKET_Shape(&packet_w, &packet_h);
+    uint32_t width = (uint32_t)cpu->frame.width;
+    uint32_t height = (uint32_t)cpu->frame.height;
+    uint32_t tile_x = (tile % cpu->tiles.columns) * cpu->tiles.size;
+    uint32_t tile_y = (tile / cpu->tiles.columns) * cpu->tiles.size;
+    uint32_t tile_end_x = tile_x + cpu->tiles.size < width ? tile_x + cpu->tiles.size : width;
+    uint32_t tile_end_y = tile_y + cpu->tiles.size < height ? tile_y + cpu->tiles.size : height;
+    uint32_t xs[CPU_PACKET_MAX_WIDTH];
+    uint32_t ys[CPU_PACKET_MAX_WIDTH];
+    for (uint32_t y = tile_y; y < tile_end_y; y += packet_h) {
+        for (uint32_t x = tile_x; x < tile_end_x; x += packet_w) {
+            size_t count = 0;
+            for (uint32_t py = y; py < y + packet_h && py < tile_end_y; py++) {
+                for (uint32_t px = x; px < x + packet_w && px < tile_end_x; px++) {
+                    xs[count] = px;
+                    ys[count++] = py;
+                }
+            }
+            CPACKET_Pixels(invocation, xs, ys, count);
+        }
+    }
+}
+
+BOOL CUPDT_NextTile(CPUObject* cpu, CPUWorker* worker, uint32_t* tile) {
+    // own tiles come off the front, in morton order
+    CPUDeque* deque = &(worker->deque);
+    pthread_mutex_lock(&(deque->lock));
+    BOOL found = deque->head < deque->tail;
+    if (found) *tile = deque->tiles[deque->head++];
+    pthread_mutex_unlock(&(deque->lock));
+    if (found) return TRUE;
+
+    // steal from the back of everyone else, furthest from where they are working
+    for (size_t i = 1; i < cpu->workers.count; i++) {
+        CPUDeque* victim = &(cpu->workers.list[(worker->id + i) % cpu->workers.count].deque);
+        pthread_mutex_lock(&(victim->lock));
+        found = victim->head < victim->tail;
+        if (found) *tile = victim->tiles[--victim->tail];
+        pthread_mutex_unlock(&(victim->lock));
+        if (found) return TRUE;
+    }
+    return FALSE;
+}
+
+void* CUPDT_Worker(void* arg) {
+    CPUWorker* worker = (CPUWorker*)arg;
+    CPUObject* cpu = &(g_cupdt_renderer_ref->cpu);
+    CPUWorkers* workers = &(cpu->workers);
+    uint64_t generation = 0;
+    pthread_mutex_lock(&(workers->lock));
+    while (TRUE) {
+        while (workers->running && workers->generation == generation)
+            pthread_cond_wait(&(workers->wake), &(workers->lock));
+        if (!workers->running) break;
+        generation = workers->generation;
+        pthread_mutex_unlock(&(workers->lock));
+
+        CPUInvocation invocation = { 0 };
+        invocation.frame = &(cpu->frame);
+        invocation.geometry = &(cpu->geometry);
+        invocation.ages = cpu->ages;
+        invocation.output = cpu->output;
+        invocation.albedo = cpu->albedo;
+        invocation.normals = cpu->normals;
+        uint32_t tile;
+        while (CUPDT_NextTile(cpu, worker, &tile)) CUPDT_Tile(cpu, &invocation, tile);
+
+        // filter with the surfaces this frame was traced with, every pass waits for the whole image
+        if (cpu->frame.denoise && cpu->albedo != NULL) {
+            for (uint32_t pass = 0; pass < DENOISE_ITERATIONS; pass++) {
+                pthread_barrier_wait(&(workers->stage));
+                CUPDT_Deal(cpu, worker);
+                while (CUPDT_NextTile(cpu, worker, &tile)) CUPDT_DenoiseTile(cpu, pass, tile);
+            }
+        }
+
+        pthread_mutex_lock(&(workers->lock));
+        workers->busy--;
+        if (workers->busy == 0) pthread_cond_broadcast(&(workers->done));
+    }
+    pthread_mutex_unlock(&(workers->lock));
+    return NULL;
+}
+
+void CUPDT_Deal(CPUObject* cpu, CPUWorker* worker) {
+    // hand the worker a contiguous run of the morton order so its tiles stay close together
+    CPUDeque* deque = &(worker->deque);
+    size_t start = cpu->tiles.count * worker->id / cpu->workers.count;
+    size_t end = cpu->tiles.count * (worker->id + 1) / cpu->workers.count;
+    pthread_mutex_lock(&(deque->lock));
+    memcpy(deque->tiles, &(cpu->tiles.order[start]), (end - start) * sizeof(uint32_t));
+    deque->head = 0;
+    deque->tail = end - start;
+    pthread_mutex_unlock(&(deque->lock));
+}
+
+void CUPDT_Dispatch(CPUObject* cpu) {
+    CUPDT_Tiles(cpu);
+    for (size_t i = 0; i < cpu->workers.count; i++) CUPDT_Deal(cpu, &(cpu->workers.list[i]));
+
+    pthread_mutex_lock(&(cpu->workers.lock));
+    cpu->workers.busy = cpu->workers.count;
+    cpu->workers.generation++;
+    pthread_cond_broadcast(&(cpu->workers.wake));
+    pthread_mutex_unlock(&(cpu->workers.lock));
+    cpu->dispatched = TRUE;
+}
+
+BOOL CUPDT_Finished(CPUObject* cpu) {
+    pthread_mutex_lock(&(cpu->workers.lock));
+    BOOL finished = cpu->workers.busy == 0;
+    pthread_mutex_unlock(&(cpu->workers.lock));
+    return finished;
+}
+
+void CUPDT_Wait(CPUObject* cpu) {
+    pthread_mutex_lock(&(cpu->workers.lock));
+    while (cpu->workers.busy > 0)
+        pthread_cond_wait(&(cpu->workers.done), &(cpu->workers.lock));
+    pthread_mutex_unlock(&(cpu->workers.lock));
+}
+
+void CUPDT_Surfaces(CPUObject* cpu) {
+    if (cpu->albedo != NULL) return;
+    size_t pixels = (size_t)g_cupdt_renderer_ref->dimensions.x * (size_t)g_cupdt_renderer_ref->dimensions.y;
+    cpu->albedo = EZALLOC(pixels, 4 * sizeof(float));
+    cpu->normals = EZALLOC(pixels, 4 * sizeof(float));
+    cpu->filtered[0] = EZALLOC(pixels, 4 * sizeof(float));
+    cpu->filtered[1] = EZALLOC(pixels, 4 * sizeof(float));
+}
+
+float DenoiseSurfaceWeight(float* a, float* b, float spacing) {
+    // sky only blends with sky, surfaces need a similar facing and distance
+    if (a[3] <= 0.0f || b[3] <= 0.0f) return a[3] <= 0.0f && b[3] <= 0.0f ? 1.0f : 0.0f;
+    float facing = powf(fmaxf(glm_vec3_dot(a, b), 0.0f), DENOISE_SIGMA_NORMAL);
+    float distance = expf(-fabsf(a[3] - b[3]) / (DENOISE_SIGMA_DEPTH * a[3] * spacing + EPS));
+    return facing * distance;
+}
+
+void DenoiseLoad(CPUObject* cpu, uint32_t pass, size_t ind, vec4 color) {
+    // the first pass divides albedo out so texture detail is not blurred, alpha marks traced pixels
+    if (pass == 0) {
+        for (int c = 0; c < 3; c++)
+            color[c] = (cpu->output[ind + c] / 255.0f) / fmaxf(cpu->albedo[ind + c], DENOISE_ALBEDO_MIN);
+        color[3] = cpu->output[ind + 3];
+        return;
+    }
+    glm_vec4_copy(&(cpu->filtered[(pass - 1) % 2][ind]), color);
+}
+
+void DenoiseStore(CPUObject* cpu, uint32_t pass, size_t ind, vec4 color) {
+    // the last pass puts albedo back and writes the target the same way a unorm storage image would
+    if (pass == DENOISE_ITERATIONS - 1) {
+        for (int c = 0; c < 3; c++) {
+            float value = color[c] * fmaxf(cpu->albedo[ind + c], DENOISE_ALBEDO_MIN);
+            cpu->output[ind + c] = (uint8_t)(glm_clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+        return;
+    }
+    glm_vec4_copy(color, &(cpu->filtered[pass % 2][ind]));
+}
+
+void CUPDT_DenoiseTile(CPUObject* cpu, uint32_t pass, uint32_t tile) {
+    // same passes as shaders/denoise.comp, taps stay inside the region
+    PixelRegion region = cpu->frame.region;
+    size_t width = (size_t)cpu->frame.stride;
+    float kernel[3] = { 3.0f / 8.0f, 1.0f / 4.0f, 1.0f / 16.0f };
+    int spacing = 1 << pass;
+    float sigma = DENOISE_SIGMA_COLOR / (float)spacing;
+    uint32_t tile_x = (tile % cpu->tiles.columns) * cpu->tiles.size;
+    uint32_t tile_y = (tile / cpu->tiles.columns) * cpu->tiles.size;
+    uint32_t start_x = tile_x > region.x ? tile_x : region.x;
+    uint32_t start_y = tile_y > region.y ? tile_y : region.y;
+    uint32_t end_x = tile_x + cpu->tiles.size < region.x + region.width ? tile_x + cpu->tiles.size : region.x + region.width;
+    uint32_t end_y = tile_y + cpu->tiles.size < region.y + region.height ? tile_y + cpu->tiles.size : region.y + region.height;
+    for (uint32_t y = start_y; y < end_y; y++) {
+        for (uint32_t x = start_x; x < end_x; x++) {
+            size_t ind = (y * width + x) * 4;
+            vec4 color;
+            DenoiseLoad(cpu, pass, ind, color);
+            if (color[3] == 0.0f) {
+                DenoiseStore(cpu, pass, ind, color);
+                continue;
+            }
+            vec3 sum = { 0.0f, 0.0f, 0.0f };
+            float weights = 0.0f;
+            for (int dy = -2; dy <= 2; dy++) {
+                for (int dx = -2; dx <= 2; dx++) {
+                    int64_t tx = (int64_t)x + dx * spacing;
+                    int64_t ty = (int64_t)y + dy * spacing;
+                    if (tx < region.x || ty < region.y || tx >= region.x + region.width || ty >= region.y + region.height) continue;
+                    size_t tap = ((size_t)ty * width + (size_t)tx) * 4;
+                    vec4 neighbor;
+                    DenoiseLoad(cpu, pass, tap, neighbor);
+                    if (neighbor[3] == 0.0f) continue;
+                    vec3 difference;
+                    glm_vec3_sub(neighbor, color, difference);
+                    float weight = kernel[abs(dx)] * kernel[abs(dy)];
+                    weight *= expf(-glm_vec3_dot(difference, difference) / (sigma * sigma));
+                    weight *= DenoiseSurfaceWeight(&(cpu->normals[ind]), &(cpu->normals[tap]), (float)spacing);
+                    glm_vec3_muladds(neighbor, weight, sum);
+                    weights += weight;
+                }
+            }
+            glm_vec3_divs(sum, weights, color);
+            DenoiseStore(cpu, pass, ind, color);
+        }
+    }
+}
+
+void CUPDT_SetCPUUpdateContext(Renderer* renderer) {
+    g_cupdt_renderer_ref = renderer;
+}
@@ -0,0 +1,34 @@
+#ifndef CUPDATE_H
+#define CUPDATE_H
+
+#include "renderer/vulkan/vstructs.h"
+
+void CUPDT_Geometry(CPUGeometry* geometry);
+
+void CUPDT_Frame(CPUFrame* frame);
+
+void CUPDT_Extent(CPUObject* cpu);
+
+void CUPDT_Tiles(CPUObject* cpu);
+
+void CUPDT_Tile(CPUObject* cpu, CPUInvocation* invocation, uint32_t tile);
+
+BOOL CUPDT_NextTile(CPUObject* cpu, CPUWorker* worker, uint32_t* tile);
+
+void* CUPDT_Worker(void* arg);
+
+void CUPDT_Deal(CPUObject* cpu, CPUWorker* worker);
+
+void CUPDT_Dispatch(CPUObject* cpu);
+
+BOOL CUPDT_Finished(CPUObject* cpu);
+
+void CUPDT_Wait(CPUObject* cpu);
+
+void CUPDT_Surfaces(CPUObject* cpu);
+
+void CUPDT_DenoiseTile(CPUObject* cpu, uint32_t pass, uint32_t tile);
+
+void CUPDT_SetCPUUpdateContext(Renderer* renderer);
+
+#endif
@@ -0,0 +1,36 @@
+#include "cutils.h"
+#include <easymemory.h>
+#include <string.h>
+#include <pthread.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+Renderer* g_cutil_renderer_ref = NULL;
+
+void CUTIL_SetCPUUtilsContext(Renderer* renderer) {
+    g_cutil_renderer_ref = renderer;
+}
+
+size_t CUTIL_CoreCount() {
+#ifdef _WIN32
+    // windows.h clashes with raylib, so ask winpthreads instead
+    long count = (long)pthread_num_processors_np();
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return count > 0 ? (size_t)count : 1;
+}
+
+void CUTIL_CopyToBuffer(void* hostdata, size_t count, size_t stride, CPUDataBuffer* buffer) {
+    if (buffer->data != NULL) EZFREE(buffer->data);
+    buffer->data = count > 0 ? EZALLOC(count, stride) : NULL;
+    buffer->size = count;
+    if (count > 0) memcpy(buffer->data, hostdata, count * stride);
+}
+
+void CUTIL_DestroyBuffer(CPUDataBuffer* buffer) {
+    if (buffer->data != NULL) EZFREE(buffer->data);
+    buffer->data = NULL;
+    buffer->size = 0;
+}
@@ -0,0 +1,14 @@
+#ifndef CUTILS_H
+#define CUTILS_H
+
+#include "renderer/vulkan/vstructs.h"
+
+void CUTIL_SetCPUUtilsContext(Renderer* renderer);
+
+size_t CUTIL_CoreCount();
+
+void CUTIL_CopyToBuffer(void* hostdata, size_t count, size_t stride, CPUDataBuffer* buffer);
+
+void CUTIL_DestroyBuffer(CPUDataBuffer* buffer);
+
+#endif
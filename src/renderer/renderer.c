@@ -1,402 +1,576 @@
-#include "renderer.h"
-#include "core/log.h"
-#include "renderer/vulkan/vutils.h"
-#include "renderer/vulkan/vinit.h"
-#include "renderer/vulkan/vupdate.h"
-#include "renderer/vulkan/vclean.h"
-#include "renderer/rutils.h"
-#include <GLFW/glfw3.h>
-#include <easymemory.h>
-#include <string.h>
-#include <time.h>
-
-Renderer g_renderer = { 0 };
-TriangleID g_triangle_id = 0;
-SDFID g_sdf_id = 0;
-LightID g_light_id = 0;
-Vector2 g_override_resolution = { 0 };
-float g_rft = 0.0f;
-
-void SetViewportSlice(size_t w, size_t h) {
-	float psuedo_w = w * (g_renderer.dimensions.x / (float)GetScreenWidth());
-	float psuedo_h = h * (g_renderer.dimensions.y / (float)GetScreenHeight());
-    g_renderer.viewport = (Vector2) { ceil(psuedo_w), ceil(psuedo_h) };
-}
-
-void OverrideResolution(size_t x, size_t y) {
-	g_override_resolution = (Vector2){ x, y };
-}
-
-void InitializeRenderer() {
-	// init rand
-	srand(time(NULL));
-
-    // initialize config
-    g_renderer.config.frameless = FRAMELESS_CHANCE;
-	g_renderer.config.shadows = TRUE;
-	g_renderer.config.reflections = TRUE;
-	g_renderer.config.lighting = TRUE;
-	g_renderer.config.raytrace = TRUE;
-	g_renderer.config.sdf = FALSE;
-    g_renderer.config.sdfsmooth = 0.0f;
-    g_renderer.config.maxmarches = 100;
-    g_renderer.config.antialiasing = FALSE;
-
-    // initialize camera
-    g_renderer.camera.position = (Vector3){ 2.0f, 2.0f, 2.0f };
-    g_renderer.camera.look = (Vector3){ 0.0f, 0.0f, 0.0f };
-    g_renderer.camera.up = (Vector3){ 0.0f, 0.0f, 1.0f };
-
-    // set up dimensions
-    g_renderer.dimensions = (Vector2){ 
-		g_override_resolution.x == 0 ? GetScreenWidth() : g_override_resolution.x,
-		g_override_resolution.y == 0 ? GetScreenHeight() : g_override_resolution.y };
-
-    // initialize vulkan resources
-	VUTIL_SetVulkanUtilsContext(&g_renderer);
-	VINIT_SetVulkanInitContext(&g_renderer);
-	VUPDT_SetVulkanUpdateContext(&g_renderer);
-	VCLEAN_SetVulkanCleanContext(&g_renderer);
-	BOOL result = VINIT_Vulkan(&(g_renderer.vulkan));
-	LOG_ASSERT(result, "Failed to initialize vulkan");
-
-    // set up cpu swap
-	g_renderer.swapchain.target = LoadRenderTexture(g_renderer.dimensions.x, g_renderer.dimensions.y);
-	LOG_ASSERT(IsRenderTextureValid(g_renderer.swapchain.target), "Unable to load target texture");
-
-    // configure stat profiler
-    ConfigureProfile(&(g_renderer.stats.profile), "Renderer", 10);
-}
-
-void DestroyRenderer() {
-    // clean geometry
-    ClearTriangles();
-    ClearMaterials();
-    ClearSDFs();
-    ClearLights();
-    ARRLIST_NodeBVH_clear(&(g_renderer.geometry.bvh));
-
-    // destroy vulkan resources
-    VCLEAN_Vulkan(&(g_renderer.vulkan));
-
-    // unload cpu swap textures
-	UnloadRenderTexture(g_renderer.swapchain.target);
-}
-
-SimpleCamera GetCamera() {
-    return g_renderer.camera;
-}
-
-void MoveCamera(SimpleCamera camera) {
-    g_renderer.camera = camera;
-}
-
-TriangleID SubmitTriangle(Triangle triangle) {
-    g_renderer.geometry.changes.update_triangles = TRUE;
-    TriangleBB bb = {
-        {
-            triangle.a[0] < triangle.b[0] ?
-                (triangle.a[0] < triangle.c[0] ? triangle.a[0] : triangle.c[0]) :
-                (triangle.b[0] < triangle.c[0] ? triangle.b[0] : triangle.c[0]),
-            triangle.a[1] < triangle.b[1] ?
-                (triangle.a[1] < triangle.c[1] ? triangle.a[1] : triangle.c[1]) :
-                (triangle.b[1] < triangle.c[1] ? triangle.b[1] : triangle.c[1]),
-            triangle.a[2] < triangle.b[2] ?
-                (triangle.a[2] < triangle.c[2] ? triangle.a[2] : triangle.c[2]) :
-                (triangle.b[2] < triangle.c[2] ? triangle.b[2] : triangle.c[2])
-        },
-        {
-            triangle.a[0] > triangle.b[0] ?
-                (triangle.a[0] > triangle.c[0] ? triangle.a[0] : triangle.c[0]) :
-                (triangle.b[0] > triangle.c[0] ? triangle.b[0] : triangle.c[0]),
-            triangle.a[1] > triangle.b[1] ?
-                (triangle.a[1] > triangle.c[1] ? triangle.a[1] : triangle.c[1]) :
-                (triangle.b[1] > triangle.c[1] ? triangle.b[1] : triangle.c[1]),
-            triangle.a[2] > triangle.b[2] ?
-                (triangle.a[2] > triangle.c[2] ? triangle.a[2] : triangle.c[2]) :
-                (triangle.b[2] > triangle.c[2] ? triangle.b[2] : triangle.c[2])
-        },
-        { 0, 0, 0 }
-    };
-    bb.centroid[0] = ((bb.max[0] - bb.min[0]) / 2.0f) + bb.min[0];
-    bb.centroid[1] = ((bb.max[1] - bb.min[1]) / 2.0f) + bb.min[1];
-    bb.centroid[2] = ((bb.max[2] - bb.min[2]) / 2.0f) + bb.min[2]; 
-    ARRLIST_TriangleID_add(&(g_renderer.geometry.tids), g_triangle_id);
-    ARRLIST_TriangleBB_add(&(g_renderer.geometry.tbbs), bb);
-    ARRLIST_Triangle_add(&(g_renderer.geometry.triangles), triangle);
-    g_triangle_id++;
-    return g_triangle_id - 1;
-}
-
-void RemoveTriangle(TriangleID id) {
-    size_t ind = 0;
-    BOOL found = false;
-    for (size_t i = 0; i < g_renderer.geometry.tids.size; i++) {
-        if (g_renderer.geometry.tids.data[i] == id) {
-            ind = i;
-            found = TRUE;
-            break;
-        }
-    }
-    if (found) {
-        ARRLIST_Triangle_remove(&(g_renderer.geometry.triangles), ind);
-        ARRLIST_TriangleID_remove(&(g_renderer.geometry.tids), ind);
-        ARRLIST_TriangleBB_remove(&(g_renderer.geometry.tbbs), ind);
-        g_renderer.geometry.changes.update_triangles = TRUE;
-    } else {
-        LOG_FATAL("Unable to remove nonexistant triangle");
-    }
-}
-
-void ClearTriangles() {
-    ARRLIST_TriangleID_clear(&(g_renderer.geometry.tids));
-    ARRLIST_TriangleBB_clear(&(g_renderer.geometry.tbbs));
-    ARRLIST_Triangle_clear(&(g_renderer.geometry.triangles));
-    g_renderer.geometry.changes.update_triangles = TRUE;
-}
-
-SDFID SubmitSDF(SDFPrimitive sdf) {
-    g_renderer.geometry.changes.update_sdfs = TRUE;
-    ARRLIST_SDFID_add(&(g_renderer.geometry.sdfids), g_sdf_id);
-    ARRLIST_SDFPrimitive_add(&(g_renderer.geometry.sdfs), sdf);
-    g_sdf_id++;
-    return g_sdf_id - 1;
-}
-
-void RemoveSDF(SDFID id) {
-    size_t ind = 0;
-    BOOL found = false;
-    for (size_t i = 0; i < g_renderer.geometry.sdfids.size; i++) {
-        if (g_renderer.geometry.sdfids.data[i] == id) {
-            ind = i;
-            found = TRUE;
-            break;
-        }
-    }
-    if (found) {
-        ARRLIST_SDFPrimitive_remove(&(g_renderer.geometry.sdfs), ind);
-        ARRLIST_SDFID_remove(&(g_renderer.geometry.sdfids), ind);
-        g_renderer.geometry.changes.update_sdfs = TRUE;
-    } else {
-        LOG_FATAL("Unable to remove nonexistant sdf");
-    }
-}
-
-void ClearSDFs() {
-    ARRLIST_SDFID_clear(&(g_renderer.geometry.sdfids));
-    ARRLIST_SDFPrimitive_clear(&(g_renderer.geometry.sdfs));
-    g_renderer.geometry.changes.update_sdfs = TRUE;
-}
-
-LightID SubmitLight(PointLight light) {
-    g_renderer.geometry.changes.update_lights = TRUE;
-    ARRLIST_LightID_add(&(g_renderer.geometry.lids), g_light_id);
-    ARRLIST_PointLight_add(&(g_renderer.geometry.lights), light);
-    g_light_id++;
-    return g_light_id - 1;
-}
-
-void RemoveLight(LightID id) {
-    size_t ind = 0;
-    BOOL found = false;
-    for (size_t i = 0; i < g_renderer.geometry.lights.size; i++) {
-        if (g_renderer.geometry.lids.data[i] == id) {
-            ind = i;
-            found = TRUE;
-            break;
-        }
-    }
-    if (found) {
-        ARRLIST_PointLight_remove(&(g_renderer.geometry.lights), ind);
-        ARRLIST_LightID_remove(&(g_renderer.geometry.lids), ind);
-        g_renderer.geometry.changes.update_lights = TRUE;
-    } else {
-        LOG_FATAL("Unable to remove nonexistant light");
-    }
-}
-
-void ClearLights() {
-    ARRLIST_LightID_clear(&(g_renderer.geometry.lids));
-    ARRLIST_PointLight_clear(&(g_renderer.geometry.lights));
-    g_renderer.geometry.changes.update_lights = TRUE;
-}
-
-MaterialID SubmitMaterial(SurfaceMaterial material) {
-    ARRLIST_SurfaceMaterial_add(&(g_renderer.geometry.materials), material);
-    g_renderer.geometry.changes.update_materials = TRUE;
-    return g_renderer.geometry.materials.size - 1;
-}
-
-void ClearMaterials() {
-    ARRLIST_SurfaceMaterial_clear(&(g_renderer.geometry.materials));
-    g_renderer.geometry.changes.update_materials = TRUE;
-}
-
-void Render() {
-    static BOOL async_update = TRUE;
-
-    // update render frame time;
-    g_rft += GetFrameTime();
-
-    // detect changes in described data
-    if (async_update) {
-        // profile for stats
-        BeginProfile(&(g_renderer.stats.profile));
-
-        BOOL descriptor_changes = 
-            g_renderer.geometry.changes.update_triangles |
-            g_renderer.geometry.changes.update_materials |
-            g_renderer.geometry.changes.update_sdfs |
-            g_renderer.geometry.changes.update_lights;
-
-        // update triangles if needed
-        if (g_renderer.geometry.changes.update_triangles) {
-            vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface); // TODO: make a buffer for every swap so we don't have to wait
-            g_renderer.geometry.changes.update_triangles = FALSE;
-            if (g_renderer.geometry.changes.max_triangles != g_renderer.geometry.triangles.maxsize) {
-                g_renderer.geometry.changes.max_triangles = g_renderer.geometry.triangles.maxsize;
-                VCLEAN_Triangles(&(g_renderer.vulkan.core.geometry.triangles));
-                VINIT_Triangles(&(g_renderer.vulkan.core.geometry.triangles));
-            } else {
-                VUPDT_Triangles(&(g_renderer.vulkan.core.geometry.triangles));
-            }
-            // update bvh
-            RUTIL_BoundingVolumeHierarchy(&g_renderer.geometry.bvh, &g_renderer.geometry.tbbs);
-            if (g_renderer.geometry.changes.max_bvh != g_renderer.geometry.bvh.maxsize) {
-                g_renderer.geometry.changes.max_bvh = g_renderer.geometry.bvh.maxsize;
-                VCLEAN_BoundingVolumeHierarchy(&(g_renderer.vulkan.core.geometry.bvh));
-                VINIT_BoundingVolumeHierarchy(&(g_renderer.vulkan.core.geometry.bvh));
-            } else {
-                VUPDT_BoundingVolumeHierarchy(&(g_renderer.vulkan.core.geometry.bvh));
-            }
-        }
-
-        // update sdfs if needed
-        if (g_renderer.geometry.changes.update_sdfs) {
-            vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface); // TODO: make a buffer for every swap so we don't have to wait
-            g_renderer.geometry.changes.update_sdfs = FALSE;
-            if (g_renderer.geometry.changes.max_sdfs != g_renderer.geometry.sdfs.maxsize) {
-                g_renderer.geometry.changes.max_sdfs = g_renderer.geometry.sdfs.maxsize;
-                VCLEAN_SDFs(&(g_renderer.vulkan.core.geometry.sdfs));
-                VINIT_SDFs(&(g_renderer.vulkan.core.geometry.sdfs));
-            } else {
-                VUPDT_SDFs(&(g_renderer.vulkan.core.geometry.sdfs));
-            }
-        }
-
-        // update materials if needed
-        if (g_renderer.geometry.changes.update_materials) {
-            vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface); // TODO: make a buffer for every swap so we don't have to wait
-            g_renderer.geometry.changes.update_materials = FALSE;
-            if (g_renderer.geometry.changes.max_materials != g_renderer.geometry.materials.maxsize) {
-                g_renderer.geometry.changes.max_materials = g_renderer.geometry.materials.maxsize;
-                VCLEAN_Materials(&(g_renderer.vulkan.core.geometry.materials));
-                VINIT_Materials(&(g_renderer.vulkan.core.geometry.materials));
-            } else {
-                VUPDT_Materials(&(g_renderer.vulkan.core.geometry.materials));
-            }
-        }
-
-        // update lights if needed
-        if (g_renderer.geometry.changes.update_lights) {
-            vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface); // TODO: make a buffer for every swap so we don't have to wait
-            g_renderer.geometry.changes.update_lights = FALSE;
-            if (g_renderer.geometry.changes.max_lights != g_renderer.geometry.lights.maxsize) {
-                g_renderer.geometry.changes.max_lights = g_renderer.geometry.lights.maxsize;
-                VCLEAN_Lights(&(g_renderer.vulkan.core.geometry.lights));
-                VINIT_Lights(&(g_renderer.vulkan.core.geometry.lights));
-            } else {
-                VUPDT_Lights(&(g_renderer.vulkan.core.geometry.lights));
-            }
-        }
-
-        // update descriptor sets if needed
-        if (descriptor_changes) VUPDT_DescriptorSets(&(g_renderer.vulkan.core.context.renderdata.descriptors));
-
-        // update uniform buffers
-        VUPDT_UniformBuffers(&(g_renderer.vulkan.core.context.renderdata.ubos));
-
-        // reset renderer frame time
-        g_rft = 0.0f;
-
-        // reset command buffer and record it
-        vkResetCommandBuffer(g_renderer.vulkan.core.scheduler.commands.commands[g_renderer.swapchain.index], 0);
-        VUPDT_RecordCommand(g_renderer.vulkan.core.scheduler.commands.commands[g_renderer.swapchain.index]);
-
-        // submit command buffer
-        VkSubmitInfo submitInfo = { 0 };
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.waitSemaphoreCount = 0;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &(g_renderer.vulkan.core.scheduler.commands.commands[g_renderer.swapchain.index]);
-        submitInfo.signalSemaphoreCount = 0;
-        VkResult result = vkQueueSubmit(g_renderer.vulkan.core.scheduler.queue, 1, &submitInfo, g_renderer.vulkan.core.scheduler.syncro.fences[g_renderer.swapchain.index]);
-        LOG_ASSERT(result == VK_SUCCESS, "failed to submit draw command buffer!");
-    }
-
-    // wait for and reset rendering fence
-	size_t new_ind = (g_renderer.swapchain.index + 1) % CPUSWAP_LENGTH;
-    if (vkGetFenceStatus(g_renderer.vulkan.core.general.interface, g_renderer.vulkan.core.scheduler.syncro.fences[new_ind]) == VK_SUCCESS) {
-        vkResetFences(g_renderer.vulkan.core.general.interface, 1, &(g_renderer.vulkan.core.scheduler.syncro.fences[new_ind]));
-        g_renderer.swapchain.index = new_ind;
-        async_update = TRUE;
-
-        // update render target
-        glBindTexture(GL_TEXTURE_2D, g_renderer.swapchain.target.texture.id);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, g_renderer.dimensions.x, g_renderer.dimensions.y, GL_RGBA, GL_UNSIGNED_BYTE, g_renderer.swapchain.reference);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        
-        // end profiling
-        EndProfile(&(g_renderer.stats.profile));
-    } else {
-        async_update = FALSE;
-    }
-}
-
-void Draw(float x, float y, float w, float h) {
-	float psuedo_w = w * (g_renderer.dimensions.x / (float)GetScreenWidth());
-	float psuedo_h = h * (g_renderer.dimensions.y / (float)GetScreenHeight());
-    DrawTexturePro(
-        g_renderer.swapchain.target.texture,
-        (Rectangle){
-            (g_renderer.swapchain.target.texture.width / 2.0f) - (psuedo_w/2.0f),
-            (g_renderer.swapchain.target.texture.height / 2.0f) - (psuedo_h/2.0f),
-            psuedo_w,
-            psuedo_h },
-        (Rectangle){ x, y, w, h},
-        (Vector2){ 0, 0 },
-        0.0f,
-        WHITE);
-}
-
-float RenderTime() {
-    return ProfileResult(&(g_renderer.stats.profile));
-}
-
-size_t NumTriangles() {
-    return g_renderer.geometry.triangles.size;
-}
-
-size_t NumSDFs() {
-    return g_renderer.geometry.sdfs.size;
-}
-
-size_t NumMaterials() {
-    return g_renderer.geometry.materials.size;
-}
-
-size_t NumLights() {
-    return g_renderer.geometry.lights.size;
-}
-
-Vector2 RenderResolution() {
-    return g_renderer.dimensions;
-}
-
-RendererConfig* RenderConfig() {
-    return &(g_renderer.config);
-}
-
-float RenderFrameTime() {
-    return g_rft * CPUSWAP_LENGTH;
+#include "renderer.h"
+#include "core/log.h"
+#include "renderer/vulkan/vutils.h"
+#include "renderer/vulkan/vinit.h"
+#include "renderer/vulkan/vupdate.h"
+#include "renderer/vulkan/vclean.h"
+#include "renderer/rutils.h"
+#include "renderer/cpu/cutils.h"
+#include "renderer/cpu/cinit.h"
+#include "renderer/cpu/cupdate.h"
+#include "renderer/cpu/cclean.h"
+#include <GLFW/glfw3.h>
+#include <easymemory.h>
+#include <string.h>
+#include <time.h>
+
+Renderer g_renderer = { 0 };
+TriangleID g_triangle_id = 0;
+SDFID g_sdf_id = 0;
+LightID g_light_id = 0;
+Vector2 g_override_resolution = { 0 };
+RendererBackend g_override_backend = BACKEND_VULKAN;
+float g_rft = 0.0f;
+
+void SetViewportSlice(size_t w, size_t h) {
+    g_renderer.extent = RUTIL_ScaledExtent(g_renderer.dimensions, g_renderer.config.scale);
+	float psuedo_w = w * (g_renderer.extent.x / (float)GetScreenWidth());
+	float psuedo_h = h * (g_renderer.extent.y / (float)GetScreenHeight());
+    g_renderer.viewport = (Vector2) { ceil(psuedo_w), ceil(psuedo_h) };
+    g_renderer.region = RUTIL_ViewportRegion(g_renderer.extent, g_renderer.viewport);
+}
+
+void OverrideResolution(size_t x, size_t y) {
+	g_override_resolution = (Vector2){ x, y };
+}
+
+void OverrideBackend(RendererBackend backend) {
+	g_override_backend = backend;
+}
+
+void InitializeRenderer() {
+	// init rand
+	srand(time(NULL));
+
+    // initialize config
+    g_renderer.config.frameless = FRAMELESS_CHANCE;
+	g_renderer.config.shadows = TRUE;
+	g_renderer.config.reflections = TRUE;
+	g_renderer.config.lighting = TRUE;
+	g_renderer.config.raytrace = TRUE;
+	g_renderer.config.sdf = FALSE;
+    g_renderer.config.sdfsmooth = 0.0f;
+    g_renderer.config.maxmarches = 100;
+    g_renderer.config.antialiasing = FALSE;
+    g_renderer.config.tilesize = CPU_TILE_SIZE;
+    g_renderer.config.wavefront = FALSE;
+    g_renderer.config.accumulate = FALSE;
+    g_renderer.config.adaptive = FALSE;
+    g_renderer.config.budget = FRAMELESS_BUDGET;
+    g_renderer.config.variance = FALSE;
+    g_renderer.config.reproject = FALSE;
+    g_renderer.config.denoise = FALSE;
+    g_renderer.config.scale = 1.0f;
+    g_renderer.config.dynamicscale = FALSE;
+    g_renderer.config.interleave = 0;
+    g_renderer.config.frames = CPUSWAP_DEFAULT;
+
+    // initialize camera
+    g_renderer.camera.position = (Vector3){ 2.0f, 2.0f, 2.0f };
+    g_renderer.camera.look = (Vector3){ 0.0f, 0.0f, 0.0f };
+    g_renderer.camera.up = (Vector3){ 0.0f, 0.0f, 1.0f };
+
+    // set up dimensions
+    g_renderer.dimensions = (Vector2){ 
+		g_override_resolution.x == 0 ? GetScreenWidth() : g_override_resolution.x,
+		g_override_resolution.y == 0 ? GetScreenHeight() : g_override_resolution.y };
+    g_renderer.extent = RUTIL_ScaledExtent(g_renderer.dimensions, g_renderer.config.scale);
+    g_renderer.region = RUTIL_ViewportRegion(g_renderer.extent, g_renderer.viewport);
+    g_renderer.swapchain.length = g_renderer.config.frames;
+
+    // pick backend
+    g_renderer.backend = g_override_backend;
+    if (g_renderer.backend == BACKEND_VULKAN && !glfwVulkanSupported()) {
+        LOG_WARN("Vulkan is not supported, falling back to cpu renderer");
+        g_renderer.backend = BACKEND_CPU;
+    }
+
+    // initialize backend resources
+    if (g_renderer.backend == BACKEND_VULKAN) {
+        VUTIL_SetVulkanUtilsContext(&g_renderer);
+        VINIT_SetVulkanInitContext(&g_renderer);
+        VUPDT_SetVulkanUpdateContext(&g_renderer);
+        VCLEAN_SetVulkanCleanContext(&g_renderer);
+        BOOL result = VINIT_Vulkan(&(g_renderer.vulkan));
+        LOG_ASSERT(result, "Failed to initialize vulkan");
+    } else {
+        CUTIL_SetCPUUtilsContext(&g_renderer);
+        CINIT_SetCPUInitContext(&g_renderer);
+        CUPDT_SetCPUUpdateContext(&g_renderer);
+        CCLEAN_SetCPUCleanContext(&g_renderer);
+        BOOL result = CINIT_CPU(&(g_renderer.cpu));
+        LOG_ASSERT(result, "Failed to initialize cpu renderer");
+    }
+
+    // set up cpu swap
+	g_renderer.swapchain.target = LoadRenderTexture(g_renderer.dimensions.x, g_renderer.dimensions.y);
+	LOG_ASSERT(IsRenderTextureValid(g_renderer.swapchain.target), "Unable to load target texture");
+    g_renderer.swapchain.filtered = FALSE;
+    RUTIL_PixelStream(&(g_renderer.swapchain.stream), g_renderer.dimensions.x * g_renderer.dimensions.y * 4);
+
+    // configure stat profiler
+    ConfigureProfile(&(g_renderer.stats.profile), "Renderer", 10);
+    ConfigureProfile(&(g_renderer.stats.upload), "Upload", 10);
+    ConfigureProfile(&(g_renderer.stats.dispatch), "Dispatch", 10);
+    ConfigureProfile(&(g_renderer.stats.copy), "Copy", 10);
+}
+
+void DestroyRenderer() {
+    // clean geometry
+    ClearTriangles();
+    ClearMaterials();
+    ClearSDFs();
+    ClearLights();
+    ARRLIST_NodeBVH_clear(&(g_renderer.geometry.bvh));
+
+    // destroy backend resources
+    if (g_renderer.backend == BACKEND_VULKAN) {
+        VCLEAN_Vulkan(&(g_renderer.vulkan));
+    } else {
+        CCLEAN_CPU(&(g_renderer.cpu));
+    }
+
+    // unload cpu swap textures
+    RUTIL_DestroyPixelStream(&(g_renderer.swapchain.stream));
+	UnloadRenderTexture(g_renderer.swapchain.target);
+}
+
+SimpleCamera GetCamera() {
+    return g_renderer.camera;
+}
+
+void MoveCamera(SimpleCamera camera) {
+    g_renderer.camera = camera;
+}
+
+TriangleID SubmitTriangle(Triangle triangle) {
+    g_renderer.geometry.changes.update_triangles = TRUE;
+    TriangleBB bb = RUTIL_TriangleBounds(triangle);
+    ARRLIST_TriangleID_add(&(g_renderer.geometry.tids), g_triangle_id);
+    ARRLIST_TriangleBB_add(&(g_renderer.geometry.tbbs), bb);
+    ARRLIST_Triangle_add(&(g_renderer.geometry.triangles), triangle);
+    g_triangle_id++;
+    return g_triangle_id - 1;
+}
+
+void RemoveTriangle(TriangleID id) {
+    size_t ind = 0;
+    BOOL found = false;
+    for (size_t i = 0; i < g_renderer.geometry.tids.size; i++) {
+        if (g_renderer.geometry.tids.data[i] == id) {
+            ind = i;
+            found = TRUE;
+            break;
+        }
+    }
+    if (found) {
+        ARRLIST_Triangle_remove(&(g_renderer.geometry.triangles), ind);
+        ARRLIST_TriangleID_remove(&(g_renderer.geometry.tids), ind);
+        ARRLIST_TriangleBB_remove(&(g_renderer.geometry.tbbs), ind);
+        g_renderer.geometry.changes.update_triangles = TRUE;
+    } else {
+        LOG_FATAL("Unable to remove nonexistant triangle");
+    }
+}
+
+void ClearTriangles() {
+    ARRLIST_TriangleID_clear(&(g_renderer.geometry.tids));
+    ARRLIST_TriangleBB_clear(&(g_renderer.geometry.tbbs));
+    ARRLIST_Triangle_clear(&(g_renderer.geometry.triangles));
+    g_renderer.geometry.changes.update_triangles = TRUE;
+}
+
+SDFID SubmitSDF(SDFPrimitive sdf) {
+    g_renderer.geometry.changes.update_sdfs = TRUE;
+    ARRLIST_SDFID_add(&(g_renderer.geometry.sdfids), g_sdf_id);
+    ARRLIST_SDFPrimitive_add(&(g_renderer.geometry.sdfs), sdf);
+    g_sdf_id++;
+    return g_sdf_id - 1;
+}
+
+void RemoveSDF(SDFID id) {
+    size_t ind = 0;
+    BOOL found = false;
+    for (size_t i = 0; i < g_renderer.geometry.sdfids.size; i++) {
+        if (g_renderer.geometry.sdfids.data[i] == id) {
+            ind = i;
+            found = TRUE;
+            break;
+        }
+    }
+    if (found) {
+        ARRLIST_SDFPrimitive_remove(&(g_renderer.geometry.sdfs), ind);
+        ARRLIST_SDFID_remove(&(g_renderer.geometry.sdfids), ind);
+        g_renderer.geometry.changes.update_sdfs = TRUE;
+    } else {
+        LOG_FATAL("Unable to remove nonexistant sdf");
+    }
+}
+
+void ClearSDFs() {
+    ARRLIST_SDFID_clear(&(g_renderer.geometry.sdfids));
+    ARRLIST_SDFPrimitive_clear(&(g_renderer.geometry.sdfs));
+    g_renderer.geometry.changes.update_sdfs = TRUE;
+}
+
+LightID SubmitLight(PointLight light) {
+    g_renderer.geometry.changes.update_lights = TRUE;
+    ARRLIST_LightID_add(&(g_renderer.geometry.lids), g_light_id);
+    ARRLIST_PointLight_add(&(g_renderer.geometry.lights), light);
+    g_light_id++;
+    return g_light_id - 1;
+}
+
+void RemoveLight(LightID id) {
+    size_t ind = 0;
+    BOOL found = false;
+    for (size_t i = 0; i < g_renderer.geometry.lights.size; i++) {
+        if (g_renderer.geometry.lids.data[i] == id) {
+            ind = i;
+            found = TRUE;
+            break;
+        }
+    }
+    if (found) {
+        ARRLIST_PointLight_remove(&(g_renderer.geometry.lights), ind);
+        ARRLIST_LightID_remove(&(g_renderer.geometry.lids), ind);
+        g_renderer.geometry.changes.update_lights = TRUE;
+    } else {
+        LOG_FATAL("Unable to remove nonexistant light");
+    }
+}
+
+void ClearLights() {
+    ARRLIST_LightID_clear(&(g_renderer.geometry.lids));
+    ARRLIST_PointLight_clear(&(g_renderer.geometry.lights));
+    g_renderer.geometry.changes.update_lights = TRUE;
+}
+
+MaterialID SubmitMaterial(SurfaceMaterial material) {
+    ARRLIST_SurfaceMaterial_add(&(g_renderer.geometry.materials), material);
+    g_renderer.geometry.changes.update_materials = TRUE;
+    return g_renderer.geometry.materials.size - 1;
+}
+
+void ClearMaterials() {
+    ARRLIST_SurfaceMaterial_clear(&(g_renderer.geometry.materials));
+    g_renderer.geometry.changes.update_materials = TRUE;
+}
+
+void RenderCPU() {
+    // update render frame time
+    g_rft += GetFrameTime();
+
+    // wait for workers to finish the frame in flight
+    if (g_renderer.cpu.dispatched) {
+        if (!CUPDT_Finished(&(g_renderer.cpu))) return;
+        g_renderer.cpu.dispatched = FALSE;
+
+        // update render target
+        RUTIL_StreamPixels(
+            &(g_renderer.swapchain.stream),
+            g_renderer.swapchain.target.texture,
+            g_renderer.swapchain.regions[g_renderer.swapchain.index],
+            g_renderer.swapchain.reference);
+
+        // end profiling
+        EndProfile(&(g_renderer.stats.profile));
+        g_renderer.stats.measured = g_renderer.stats.profile.curr;
+        if (g_renderer.config.adaptive)
+            g_renderer.config.frameless = RUTIL_AdaptFrameless(g_renderer.config.frameless, g_renderer.config.budget, g_renderer.stats.measured);
+        if (g_renderer.config.dynamicscale)
+            g_renderer.config.scale = RUTIL_AdaptScale(&(g_renderer.config), g_renderer.stats.measured);
+    }
+
+    // profile for stats
+    BeginProfile(&(g_renderer.stats.profile));
+
+    // snapshot scene and frame state for the workers
+    CUPDT_Geometry(&(g_renderer.cpu.geometry));
+    CUPDT_Extent(&(g_renderer.cpu));
+    CUPDT_Frame(&(g_renderer.cpu.frame));
+    if (g_renderer.config.denoise) CUPDT_Surfaces(&(g_renderer.cpu));
+
+    // reset renderer frame time
+    g_rft = 0.0f;
+
+    // kick off workers
+    g_renderer.swapchain.regions[g_renderer.swapchain.index] = g_renderer.region;
+    CUPDT_Dispatch(&(g_renderer.cpu));
+}
+
+void RenderVulkan() {
+    static BOOL async_update = TRUE;
+
+    // update render frame time;
+    g_rft += GetFrameTime();
+
+    // detect changes in described data
+    if (async_update) {
+        // profile for stats
+        BeginProfile(&(g_renderer.stats.profile));
+
+        // resize the ring of frames in flight
+        VUPDT_SwapRing(&(g_renderer.vulkan.core.context));
+
+        // this swap's fence signaled, so the staging its last uploads read from is free
+        VUTIL_RecycleTransfers(g_renderer.swapchain.index);
+
+        BOOL descriptor_changes = 
+            g_renderer.geometry.changes.update_triangles |
+            g_renderer.geometry.changes.update_materials |
+            g_renderer.geometry.changes.update_sdfs |
+            g_renderer.geometry.changes.update_lights;
+
+        // in place uploads on the copy queue wait on the frames in flight through a semaphore and go
+        // out as soon as they are recorded, only replacing a buffer or copying on the compute queue idles
+        BOOL synchronous = !g_renderer.vulkan.core.scheduler.transfer.dedicated;
+        BOOL reallocated = FALSE;
+
+        // update triangles if needed
+        if (g_renderer.geometry.changes.update_triangles) {
+            g_renderer.geometry.changes.update_triangles = FALSE;
+            if (g_renderer.geometry.changes.max_triangles != g_renderer.geometry.triangles.maxsize) {
+                vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface);
+                g_renderer.geometry.changes.max_triangles = g_renderer.geometry.triangles.maxsize;
+                VCLEAN_Triangles(&(g_renderer.vulkan.core.geometry.triangles));
+                VINIT_Triangles(&(g_renderer.vulkan.core.geometry.triangles));
+                reallocated = TRUE;
+            } else {
+                if (synchronous) vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface);
+                VUPDT_Triangles(&(g_renderer.vulkan.core.geometry.triangles));
+            }
+
+            // the triangle copy runs while the bvh is rebuilt
+            VUTIL_SubmitTransfers(g_renderer.swapchain.index);
+            RUTIL_BoundingVolumeHierarchy(&g_renderer.geometry.bvh, &g_renderer.geometry.tbbs);
+            if (g_renderer.geometry.changes.max_bvh != g_renderer.geometry.bvh.maxsize) {
+                vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface);
+                g_renderer.geometry.changes.max_bvh = g_renderer.geometry.bvh.maxsize;
+                VCLEAN_BoundingVolumeHierarchy(&(g_renderer.vulkan.core.geometry.bvh));
+                VINIT_BoundingVolumeHierarchy(&(g_renderer.vulkan.core.geometry.bvh));
+                reallocated = TRUE;
+            } else {
+                VUPDT_BoundingVolumeHierarchy(&(g_renderer.vulkan.core.geometry.bvh));
+            }
+            VUTIL_SubmitTransfers(g_renderer.swapchain.index);
+        }
+
+        // update sdfs if needed
+        if (g_renderer.geometry.changes.update_sdfs) {
+            g_renderer.geometry.changes.update_sdfs = FALSE;
+            if (g_renderer.geometry.changes.max_sdfs != g_renderer.geometry.sdfs.maxsize) {
+                vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface);
+                g_renderer.geometry.changes.max_sdfs = g_renderer.geometry.sdfs.maxsize;
+                VCLEAN_SDFs(&(g_renderer.vulkan.core.geometry.sdfs));
+                VINIT_SDFs(&(g_renderer.vulkan.core.geometry.sdfs));
+                reallocated = TRUE;
+            } else {
+                if (synchronous) vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface);
+                VUPDT_SDFs(&(g_renderer.vulkan.core.geometry.sdfs));
+            }
+            VUTIL_SubmitTransfers(g_renderer.swapchain.index);
+        }
+
+        // update materials if needed
+        if (g_renderer.geometry.changes.update_materials) {
+            g_renderer.geometry.changes.update_materials = FALSE;
+            if (g_renderer.geometry.changes.max_materials != g_renderer.geometry.materials.maxsize) {
+                vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface);
+                g_renderer.geometry.changes.max_materials = g_renderer.geometry.materials.maxsize;
+                VCLEAN_Materials(&(g_renderer.vulkan.core.geometry.materials));
+                VINIT_Materials(&(g_renderer.vulkan.core.geometry.materials));
+                reallocated = TRUE;
+            } else {
+                if (synchronous) vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface);
+                VUPDT_Materials(&(g_renderer.vulkan.core.geometry.materials));
+            }
+            VUTIL_SubmitTransfers(g_renderer.swapchain.index);
+        }
+
+        // update lights if needed
+        if (g_renderer.geometry.changes.update_lights) {
+            g_renderer.geometry.changes.update_lights = FALSE;
+            if (g_renderer.geometry.changes.max_lights != g_renderer.geometry.lights.maxsize) {
+                vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface);
+                g_renderer.geometry.changes.max_lights = g_renderer.geometry.lights.maxsize;
+                VCLEAN_Lights(&(g_renderer.vulkan.core.geometry.lights));
+                VINIT_Lights(&(g_renderer.vulkan.core.geometry.lights));
+                reallocated = TRUE;
+            } else {
+                if (synchronous) vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface);
+                VUPDT_Lights(&(g_renderer.vulkan.core.geometry.lights));
+            }
+            VUTIL_SubmitTransfers(g_renderer.swapchain.index);
+        }
+
+        // only replaced buffers change what the sets point at, and the device is idle by then
+        if (reallocated) VUPDT_DescriptorSets(&(g_renderer.vulkan.core.context.renderdata.descriptors));
+
+        // build the wavefront queues the first time the mode is enabled
+        if (g_renderer.config.wavefront && !g_renderer.vulkan.core.context.wavefront.ready) {
+            vkDeviceWaitIdle(g_renderer.vulkan.core.general.interface);
+            VINIT_Wavefront(&(g_renderer.vulkan.core.context.wavefront));
+        }
+
+        // retrace everything if the trace resolution changed or the viewport grew
+        VUPDT_Extent(&(g_renderer.vulkan.core.context.renderdata));
+
+        // restart accumulation if the scene or view changed
+        VUPDT_Accumulation(&(g_renderer.vulkan.core.context.accumulation), descriptor_changes);
+
+        // update uniform buffers
+        VUPDT_FrameConstants(&(g_renderer.vulkan.core.context.renderdata.frame));
+        VUPDT_UniformBuffers(&(g_renderer.vulkan.core.context.renderdata.ubos));
+
+        // reset renderer frame time
+        g_rft = 0.0f;
+
+        // reset command buffer and record it
+        vkResetCommandBuffer(g_renderer.vulkan.core.scheduler.commands.commands[g_renderer.swapchain.index], 0);
+        VUPDT_RecordCommand(g_renderer.vulkan.core.scheduler.commands.commands[g_renderer.swapchain.index]);
+
+        // submit command buffer
+        VkSubmitInfo submitInfo = { 0 };
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        // the dispatch waits on every upload batch this frame sent out
+        VkPipelineStageFlags waitStages[TRANSFER_BATCHES];
+        for (size_t i = 0; i < TRANSFER_BATCHES; i++) waitStages[i] = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        VUTIL_SubmitTransfers(g_renderer.swapchain.index);
+        submitInfo.waitSemaphoreCount = g_renderer.vulkan.core.scheduler.transfer.batches[g_renderer.swapchain.index];
+        submitInfo.pWaitSemaphores = g_renderer.vulkan.core.scheduler.transfer.semaphores[g_renderer.swapchain.index];
+        submitInfo.pWaitDstStageMask = waitStages;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &(g_renderer.vulkan.core.scheduler.commands.commands[g_renderer.swapchain.index]);
+        submitInfo.signalSemaphoreCount = 0;
+        VkResult result = vkQueueSubmit(g_renderer.vulkan.core.scheduler.queue, 1, &submitInfo, g_renderer.vulkan.core.scheduler.syncro.fences[g_renderer.swapchain.index]);
+        LOG_ASSERT(result == VK_SUCCESS, "failed to submit draw command buffer!");
+    }
+
+    // wait for and reset rendering fence
+	size_t new_ind = (g_renderer.swapchain.index + 1) % g_renderer.swapchain.length;
+    if (vkGetFenceStatus(g_renderer.vulkan.core.general.interface, g_renderer.vulkan.core.scheduler.syncro.fences[new_ind]) == VK_SUCCESS) {
+        vkResetFences(g_renderer.vulkan.core.general.interface, 1, &(g_renderer.vulkan.core.scheduler.syncro.fences[new_ind]));
+        VUPDT_Timestamps(&(g_renderer.vulkan.core.scheduler.timestamps), new_ind);
+        g_renderer.swapchain.index = new_ind;
+        g_renderer.swapchain.reference = g_renderer.vulkan.core.context.bridges[new_ind].allocation.mapped;
+        async_update = TRUE;
+
+        // update render target
+        RUTIL_StreamPixels(
+            &(g_renderer.swapchain.stream),
+            g_renderer.swapchain.target.texture,
+            g_renderer.swapchain.regions[g_renderer.swapchain.index],
+            g_renderer.swapchain.reference);
+        
+        // end profiling
+        EndProfile(&(g_renderer.stats.profile));
+
+        // wall time is quantized to ui frames, so steer on gpu time when it is measured
+        g_renderer.stats.measured = g_renderer.vulkan.core.scheduler.timestamps.ready ?
+            g_renderer.stats.dispatch.curr + g_renderer.stats.copy.curr :
+            g_renderer.stats.profile.curr;
+        if (g_renderer.config.adaptive)
+            g_renderer.config.frameless = RUTIL_AdaptFrameless(g_renderer.config.frameless, g_renderer.config.budget, g_renderer.stats.measured);
+        if (g_renderer.config.dynamicscale)
+            g_renderer.config.scale = RUTIL_AdaptScale(&(g_renderer.config), g_renderer.stats.measured);
+    } else {
+        async_update = FALSE;
+    }
+}
+
+void Render() {
+    if (g_renderer.backend == BACKEND_VULKAN) {
+        RenderVulkan();
+    } else {
+        RenderCPU();
+    }
+}
+
+void Draw(float x, float y, float w, float h) {
+    // only the top left extent of the target is traced, filter it only while it is upscaled
+    // so a full resolution target maps texel to pixel
+    BOOL upscaled = g_renderer.extent.x < g_renderer.dimensions.x || g_renderer.extent.y < g_renderer.dimensions.y;
+    if (upscaled != g_renderer.swapchain.filtered) {
+        SetTextureFilter(g_renderer.swapchain.target.texture, upscaled ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT);
+        g_renderer.swapchain.filtered = upscaled;
+    }
+
+    // snap the source origin to the first texel the viewport region traces
+	float psuedo_w = w * (g_renderer.extent.x / (float)GetScreenWidth());
+	float psuedo_h = h * (g_renderer.extent.y / (float)GetScreenHeight());
+    DrawTexturePro(
+        g_renderer.swapchain.target.texture,
+        (Rectangle){
+            ceilf((g_renderer.extent.x - psuedo_w) / 2.0f),
+            ceilf((g_renderer.extent.y - psuedo_h) / 2.0f),
+            psuedo_w,
+            psuedo_h },
+        (Rectangle){ x, y, w, h},
+        (Vector2){ 0, 0 },
+        0.0f,
+        WHITE);
+}
+
+float RenderTime() {
+    return ProfileResult(&(g_renderer.stats.profile));
+}
+
+float RenderBudgetTime() {
+    return g_renderer.stats.measured;
+}
+
+float RenderUploadTime() {
+    return ProfileResult(&(g_renderer.stats.upload));
+}
+
+float RenderDispatchTime() {
+    return ProfileResult(&(g_renderer.stats.dispatch));
+}
+
+float RenderCopyTime() {
+    return ProfileResult(&(g_renderer.stats.copy));
+}
+
+size_t NumTriangles() {
+    return g_renderer.geometry.triangles.size;
+}
+
+size_t NumSDFs() {
+    return g_renderer.geometry.sdfs.size;
+}
+
+size_t NumMaterials() {
+    return g_renderer.geometry.materials.size;
+}
+
+size_t NumLights() {
+    return g_renderer.geometry.lights.size;
+}
+
+Vector2 RenderResolution() {
+    return g_renderer.extent;
+}
+
+BVHReport ReportBVH() {
+    return RUTIL_ReportBVH(&(g_renderer.geometry.bvh), &(g_renderer.geometry.tbbs));
+}
+
+MemoryReport ReportMemory() {
+    if (g_renderer.backend != BACKEND_VULKAN) return (MemoryReport){ 0 };
+    return g_renderer.vulkan.core.memory.report;
+}
+
+RendererConfig* RenderConfig() {
+    return &(g_renderer.config);
+}
+
+RendererBackend RenderBackend() {
+    return g_renderer.backend;
+}
+
+float RenderFrameTime() {
+    // cpu frames are never overlapped, so no swap correction is needed
+    if (g_renderer.backend == BACKEND_CPU) return g_rft;
+    return g_rft * g_renderer.swapchain.length;
 }
\ No newline at end of file
@@ -1,11 +1,11 @@
-#include "rstructs.h"
-
-IMPL_ARRLIST(TriangleID);
-IMPL_ARRLIST(SDFID);
-IMPL_ARRLIST(Triangle);
-IMPL_ARRLIST(TriangleBB);
-IMPL_ARRLIST(SurfaceMaterial);
-IMPL_ARRLIST(NodeBVH);
-IMPL_ARRLIST(SDFPrimitive);
-IMPL_ARRLIST(LightID);
+#include "rstructs.h"
+
+IMPL_ARRLIST(TriangleID);
+IMPL_ARRLIST(SDFID);
+IMPL_ARRLIST(Triangle);
+IMPL_ARRLIST(TriangleBB);
+IMPL_ARRLIST(SurfaceMaterial);
+IMPL_ARRLIST(NodeBVH);
+IMPL_ARRLIST(SDFPrimitive);
+IMPL_ARRLIST(LightID);
 IMPL_ARRLIST(PointLight);
\ No newline at end of file
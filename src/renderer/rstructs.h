@@ -1,157 +1,220 @@
-#ifndef RSTRUCTS_H
-#define RSTRUCTS_H
-
-#include "data/config.h"
-#include "data/profile.h"
-#include "renderer/vulkan/vconfig.h"
-#include <easyobjects.h>
-#include <raylib.h>
-#define CGLM_FORCE_DEPTH_ZERO_TO_ONE
-#include <cglm/cglm.h>
-
-typedef uint32_t MaterialID;
-typedef uint64_t TriangleID;
-typedef uint64_t SDFID;
-typedef uint32_t LightID;
-DECLARE_ARRLIST(TriangleID);
-DECLARE_ARRLIST(SDFID);
-DECLARE_ARRLIST(LightID);
-
-typedef struct {
-    Vector3 position;
-    Vector3 look;
-    Vector3 up;
-	float fov;
-} SimpleCamera;
-
-typedef struct {
-    alignas(16) vec3 a;
-    alignas(16) vec3 b;
-    alignas(16) vec3 c;
-    alignas(4) MaterialID material;
-} Triangle;
-DECLARE_ARRLIST(Triangle);
-
-typedef enum {
-    SDF_SPHERE = 0,
-    SDF_JULIA = 1,
-    SDF_MANDELBULB = 2,
-	SDF_BOX = 3,
-} SDFType;
-
-typedef struct {
-    alignas(4) uint32_t type;
-    alignas(16) vec3 origin;
-    alignas(4) float scale;
-	alignas(16) vec3 dim;
-} SDFPrimitive;
-DECLARE_ARRLIST(SDFPrimitive);
-
-typedef struct {
-    vec3 min;
-    vec3 max;
-    vec3 centroid;
-} TriangleBB;
-DECLARE_ARRLIST(TriangleBB);
-
-typedef struct {
-    alignas(16) vec3 ambient;
-    alignas(16) vec3 diffuse;
-    alignas(16) vec3 specular;
-    alignas(4) float reflect;
-    alignas(4) float refract;
-    alignas(4) float rindex;
-    alignas(4) float transparency;
-    alignas(4) float shiny;
-    alignas(4) float glossy;
-} SurfaceMaterial;
-DECLARE_ARRLIST(SurfaceMaterial);
-
-#define BVH_LEAF 0
-#define BVH_LEFT_ONLY 1
-#define BVH_RIGHT_ONLY 2
-#define BVH_BOTH 3
-
-typedef const char* StaticString;
-DECLARE_ARRLIST(StaticString);
-
-typedef struct {
-    alignas(4) uint32_t x;
-    alignas(4) uint32_t y;
-	alignas(4) float time;
-} RayGenerator;
-
-typedef struct {
-    uint32_t value;
-    BOOL exists;
-} Schrodingnum;
-
-typedef struct {
-    alignas(16) vec3 min;
-    alignas(16) vec3 max;
-    alignas(4) uint32_t branch_config;
-    alignas(4) uint32_t left;
-    alignas(4) uint32_t right;
-    // branches[0] describes: 0 = leaf, 1 = left tree, 2 = right tree, 3 = both
-    // branches[1] is left tree ind
-    // branches[2] is right tree ind
-} NodeBVH;
-DECLARE_ARRLIST(NodeBVH);
-
-typedef struct {
-	RenderTexture2D target;
-	size_t index;
-    void* reference;
-} CPUSwap;
-
-typedef struct {
-    size_t max_triangles;
-    size_t max_bvh;
-    size_t max_materials;
-    size_t max_sdfs;
-    size_t max_lights;
-    BOOL update_triangles;
-    BOOL update_materials;
-    BOOL update_sdfs;
-    BOOL update_lights;
-} ChangeSet;
-
-typedef struct {
-    Profiler profile;
-} RendererStats;
-
-typedef struct {
-    alignas(16) vec3 position;
-    alignas(16) vec3 ambient;
-    alignas(16) vec3 diffuse;
-    alignas(16) vec3 specular;
-} PointLight;
-DECLARE_ARRLIST(PointLight);
-
-typedef struct {
-    ARRLIST_PointLight lights;
-    ARRLIST_LightID lids;
-    ARRLIST_Triangle triangles;
-    ARRLIST_TriangleID tids;
-    ARRLIST_TriangleBB tbbs;
-    ARRLIST_SurfaceMaterial materials;
-    ARRLIST_NodeBVH bvh;
-    ARRLIST_SDFPrimitive sdfs;
-    ARRLIST_SDFID sdfids;
-    ChangeSet changes;
-} Geometry;
-
-typedef struct {
-    float frameless;
-	BOOL shadows;
-	BOOL reflections;
-	BOOL lighting;
-    BOOL raytrace;
-    BOOL sdf;
-    float sdfsmooth;
-    uint32_t maxmarches;
-    float time;
-    BOOL antialiasing;
-} RendererConfig;
-
-#endif
+#ifndef RSTRUCTS_H
+#define RSTRUCTS_H
+
+#include "data/config.h"
+#include "data/profile.h"
+#include "renderer/vulkan/vconfig.h"
+#include <easyobjects.h>
+#include <raylib.h>
+#define CGLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <cglm/cglm.h>
+
+typedef uint32_t MaterialID;
+typedef uint64_t TriangleID;
+typedef uint64_t SDFID;
+typedef uint32_t LightID;
+DECLARE_ARRLIST(TriangleID);
+DECLARE_ARRLIST(SDFID);
+DECLARE_ARRLIST(LightID);
+
+typedef struct {
+    Vector3 position;
+    Vector3 look;
+    Vector3 up;
+	float fov;
+} SimpleCamera;
+
+typedef struct {
+    alignas(16) vec3 a;
+    alignas(16) vec3 b;
+    alignas(16) vec3 c;
+    alignas(4) MaterialID material;
+} Triangle;
+DECLARE_ARRLIST(Triangle);
+
+typedef enum {
+    SDF_SPHERE = 0,
+    SDF_JULIA = 1,
+    SDF_MANDELBULB = 2,
+	SDF_BOX = 3,
+} SDFType;
+
+typedef struct {
+    alignas(4) uint32_t type;
+    alignas(16) vec3 origin;
+    alignas(4) float scale;
+	alignas(16) vec3 dim;
+} SDFPrimitive;
+DECLARE_ARRLIST(SDFPrimitive);
+
+typedef struct {
+    vec3 min;
+    vec3 max;
+    vec3 centroid;
+} TriangleBB;
+DECLARE_ARRLIST(TriangleBB);
+
+typedef struct {
+    alignas(16) vec3 ambient;
+    alignas(16) vec3 diffuse;
+    alignas(16) vec3 specular;
+    alignas(4) float reflect;
+    alignas(4) float refract;
+    alignas(4) float rindex;
+    alignas(4) float transparency;
+    alignas(4) float shiny;
+    alignas(4) float glossy;
+} SurfaceMaterial;
+DECLARE_ARRLIST(SurfaceMaterial);
+
+#define BVH_LEAF 0
+#define BVH_LEFT_ONLY 1
+#define BVH_RIGHT_ONLY 2
+#define BVH_BOTH 3
+
+typedef const char* StaticString;
+DECLARE_ARRLIST(StaticString);
+
+typedef struct {
+    uint32_t value;
+    BOOL exists;
+} Schrodingnum;
+
+typedef struct {
+    alignas(16) vec3 min;
+    alignas(16) vec3 max;
+    alignas(4) uint32_t branch_config;
+    alignas(4) uint32_t left;
+    alignas(4) uint32_t right;
+    // branches[0] describes: 0 = leaf, 1 = left tree, 2 = right tree, 3 = both
+    // branches[1] is left tree ind
+    // branches[2] is right tree ind
+} NodeBVH;
+DECLARE_ARRLIST(NodeBVH);
+
+#define BVH_REPORT_BUCKETS 8
+
+typedef struct {
+    size_t nodes;
+    size_t leaves;
+    size_t triangles;
+    size_t reachable;
+    size_t duplicates;
+    size_t invalid;
+    size_t uncontained;
+    size_t maxdepth;
+    float avgdepth;
+    float sahcost;
+    float avgoverlap;
+    float maxoverlap;
+    size_t memory;
+    size_t reserved;
+    size_t histogram[BVH_REPORT_BUCKETS];
+    BOOL valid;
+} BVHReport;
+
+typedef struct {
+    size_t reserved;
+    size_t used;
+    size_t peak;
+    size_t blocks;
+    size_t dedicated;
+    size_t allocations;
+} MemoryReport;
+
+typedef struct {
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+} PixelRegion;
+
+typedef struct {
+    uint32_t buffers[PIXELSTREAM_LENGTH];
+    size_t index;
+    size_t size;
+    BOOL ready;
+} PixelStream;
+
+typedef struct {
+	RenderTexture2D target;
+	PixelStream stream;
+	PixelRegion regions[CPUSWAP_MAX];
+	size_t index;
+    size_t length;
+    BOOL filtered;
+    void* reference;
+} CPUSwap;
+
+typedef struct {
+    size_t max_triangles;
+    size_t max_bvh;
+    size_t max_materials;
+    size_t max_sdfs;
+    size_t max_lights;
+    BOOL update_triangles;
+    BOOL update_materials;
+    BOOL update_sdfs;
+    BOOL update_lights;
+} ChangeSet;
+
+typedef struct {
+    Profiler profile;
+    Profiler upload;
+    Profiler dispatch;
+    Profiler copy;
+    float measured;
+} RendererStats;
+
+typedef struct {
+    alignas(16) vec3 position;
+    alignas(16) vec3 ambient;
+    alignas(16) vec3 diffuse;
+    alignas(16) vec3 specular;
+} PointLight;
+DECLARE_ARRLIST(PointLight);
+
+typedef struct {
+    ARRLIST_PointLight lights;
+    ARRLIST_LightID lids;
+    ARRLIST_Triangle triangles;
+    ARRLIST_TriangleID tids;
+    ARRLIST_TriangleBB tbbs;
+    ARRLIST_SurfaceMaterial materials;
+    ARRLIST_NodeBVH bvh;
+    ARRLIST_SDFPrimitive sdfs;
+    ARRLIST_SDFID sdfids;
+    ChangeSet changes;
+} Geometry;
+
+typedef enum {
+    BACKEND_VULKAN = 0,
+    BACKEND_CPU = 1,
+} RendererBackend;
+
+typedef struct {
+    float frameless;
+	BOOL shadows;
+	BOOL reflections;
+	BOOL lighting;
+    BOOL raytrace;
+    BOOL sdf;
+    float sdfsmooth;
+    uint32_t maxmarches;
+    float time;
+    BOOL antialiasing;
+    uint32_t tilesize;
+    BOOL wavefront;
+    BOOL accumulate;
+    BOOL adaptive;
+    float budget;
+    BOOL variance;
+    BOOL reproject;
+    BOOL denoise;
+    float scale;
+    BOOL dynamicscale;
+    uint32_t interleave;
+    uint32_t frames;
+} RendererConfig;
+
+#endif
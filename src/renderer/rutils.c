@@ -1,225 +1,568 @@
-#include "rutils.h"
-#include "core/log.h"
-
-#define BVH_LIMIT 0.01f
-
-IMPL_ARRLIST(size_t);
-
-void ResizeBVH(ARRLIST_NodeBVH* bvh, size_t index) {
-    if (bvh->data[index].branch_config == BVH_BOTH) {
-        ResizeBVH(bvh, bvh->data[index].left);
-        ResizeBVH(bvh, bvh->data[index].right);
-        glm_vec3_minv(
-            bvh->data[index].min,
-            bvh->data[bvh->data[index].left].min,
-            bvh->data[index].min);
-        glm_vec3_maxv(
-            bvh->data[index].max,
-            bvh->data[bvh->data[index].left].max,
-            bvh->data[index].max);
-        glm_vec3_minv(
-            bvh->data[index].min,
-            bvh->data[bvh->data[index].right].min,
-            bvh->data[index].min);
-        glm_vec3_maxv(
-            bvh->data[index].max,
-            bvh->data[bvh->data[index].right].max,
-            bvh->data[index].max);
-    } else if (bvh->data[index].branch_config == BVH_LEFT_ONLY) {
-        ResizeBVH(bvh, bvh->data[index].left);
-        glm_vec3_minv(
-            bvh->data[index].min,
-            bvh->data[bvh->data[index].left].min,
-            bvh->data[index].min);
-        glm_vec3_maxv(
-            bvh->data[index].max,
-            bvh->data[bvh->data[index].left].max,
-            bvh->data[index].max);
-    } else if (bvh->data[index].branch_config == BVH_RIGHT_ONLY) {
-        ResizeBVH(bvh, bvh->data[index].right);
-        glm_vec3_minv(
-            bvh->data[index].min,
-            bvh->data[bvh->data[index].right].min,
-            bvh->data[index].min);
-        glm_vec3_maxv(
-            bvh->data[index].max,
-            bvh->data[bvh->data[index].right].max,
-            bvh->data[index].max);
-    } else {
-        return;
-    }
-}
-
-void SplitBVH(ARRLIST_NodeBVH* bvh, size_t index, ARRLIST_TriangleBB* geometry, ARRLIST_size_t* children) {
-    #define CBVH bvh->data[index]
-    #define BVHMIN bvh->data[index].min
-    #define BVHMAX bvh->data[index].max
-    #define COPYVEC(v1, v2) { v1[0] = v2[0]; v1[1] = v2[1]; v1[2] = v2[2]; }
-
-    // set up split boxes
-    float xyz_dist[3] = {
-        BVHMAX[0] - BVHMIN[0],
-        BVHMAX[1] - BVHMIN[1],
-        BVHMAX[2] - BVHMIN[2],
-    };
-    int dist_ind = xyz_dist[0] > xyz_dist[1] ?
-        (xyz_dist[0] > xyz_dist[2] ? 0 : 2) :
-        (xyz_dist[1] > xyz_dist[2] ? 1 : 2);
-    if (xyz_dist[dist_ind] < BVH_LIMIT) {
-        size_t stream_index = index;
-        for (size_t i = 0; i < children->size; i++) {
-            NodeBVH child = {
-                { geometry->data[children->data[i]].min[0],
-                  geometry->data[children->data[i]].min[1],
-                  geometry->data[children->data[i]].min[2] },
-                { geometry->data[children->data[i]].max[0],
-                  geometry->data[children->data[i]].max[1],
-                  geometry->data[children->data[i]].max[2] },
-                BVH_LEAF, children->data[i], 0
-            };
-            ARRLIST_NodeBVH_add(bvh, child);
-            bvh->data[stream_index].left = bvh->size - 1;
-
-            if (i + 1 >= children->size) {
-                bvh->data[stream_index].branch_config = BVH_LEFT_ONLY;
-            } else {
-                bvh->data[stream_index].branch_config = BVH_BOTH;
-                NodeBVH next = {
-                    { BVHMIN[0], BVHMIN[1], BVHMIN[2] },
-                    { BVHMAX[0], BVHMAX[1], BVHMAX[2] },
-                    BVH_LEAF, 0, 0
-                };
-                ARRLIST_NodeBVH_add(bvh, next);
-                bvh->data[stream_index].right = bvh->size - 1;
-                stream_index = bvh->size - 1;
-            }
-        }
-        ResizeBVH(bvh, index);
-        return;
-    }
-    float mid_dist = xyz_dist[dist_ind] / 2.0f;
-    NodeBVH left = {
-        { BVHMIN[0], BVHMIN[1], BVHMIN[2] },
-        { BVHMAX[0], BVHMAX[1], BVHMAX[2] },
-        BVH_LEAF, 0, 0
-    };
-    NodeBVH right = {
-        { BVHMIN[0], BVHMIN[1], BVHMIN[2] },
-        { BVHMAX[0], BVHMAX[1], BVHMAX[2] },
-        BVH_LEAF, 0, 0
-    };
-    left.max[dist_ind] -= mid_dist;
-    right.min[dist_ind] += mid_dist;
-
-    // set up subchildren
-    ARRLIST_size_t left_children = { 0 };
-    ARRLIST_size_t right_children = { 0 };
-    for (size_t i = 0; i < children->size; i++) {
-        if (geometry->data[children->data[i]].centroid[dist_ind] < left.max[dist_ind])
-            ARRLIST_size_t_add(&left_children, children->data[i]);
-        else ARRLIST_size_t_add(&right_children, children->data[i]);
-    }
-    if (left_children.size > 0 && right_children.size > 0) {
-        CBVH.branch_config = BVH_BOTH;
-    } else if (left_children.size > 0) {
-        CBVH.branch_config = BVH_LEFT_ONLY;
-    } else if (right_children.size > 0) {
-        CBVH.branch_config = BVH_RIGHT_ONLY;
-    } else {
-        LOG_FATAL("This should never happen");
-        CBVH.branch_config = BVH_LEAF;
-    }
-    if (left_children.size > 1) {
-        ARRLIST_NodeBVH_add(bvh, left);
-        CBVH.left = bvh->size - 1;
-        SplitBVH(bvh, CBVH.left, geometry, &left_children);
-    } else if (left_children.size == 1) {
-        left.branch_config = BVH_LEAF;
-        left.left = left_children.data[0];
-        COPYVEC(left.min, geometry->data[left.left].min);
-        COPYVEC(left.max, geometry->data[left.left].max);
-        ARRLIST_NodeBVH_add(bvh, left);
-        CBVH.left = bvh->size - 1;
-    }
-    if (right_children.size > 1) {
-        ARRLIST_NodeBVH_add(bvh, right);
-        CBVH.right = bvh->size - 1;
-        SplitBVH(bvh, CBVH.right, geometry, &right_children);
-    } else if (right_children.size == 1) {
-        right.branch_config = BVH_LEAF;
-        right.left = right_children.data[0];
-        COPYVEC(right.min, geometry->data[right.left].min);
-        COPYVEC(right.max, geometry->data[right.left].max);
-        ARRLIST_NodeBVH_add(bvh, right);
-        CBVH.right = bvh->size - 1;
-    }
-    ARRLIST_size_t_clear(&left_children);
-    ARRLIST_size_t_clear(&right_children);
-
-    // resize
-    if (bvh->data[index].branch_config == BVH_BOTH || bvh->data[index].branch_config == BVH_LEFT_ONLY) {
-        glm_vec3_minv(
-            bvh->data[index].min,
-            bvh->data[bvh->data[index].left].min,
-            bvh->data[index].min);
-        glm_vec3_maxv(
-            bvh->data[index].max,
-            bvh->data[bvh->data[index].left].max,
-            bvh->data[index].max);
-    }
-    if (bvh->data[index].branch_config == BVH_BOTH || bvh->data[index].branch_config == BVH_RIGHT_ONLY) {
-        glm_vec3_minv(
-            bvh->data[index].min,
-            bvh->data[bvh->data[index].right].min,
-            bvh->data[index].min);
-        glm_vec3_maxv(
-            bvh->data[index].max,
-            bvh->data[bvh->data[index].right].max,
-            bvh->data[index].max);
-    }
-    
-    
-    #undef CBVH
-    #undef BVHMIN
-    #undef BVHMAX
-    #undef COPYVEC
-}
-
-size_t CountBVH(ARRLIST_NodeBVH* bvh, size_t index) {
-    if (bvh->data[index].branch_config == BVH_LEAF) return 1;
-    if (bvh->data[index].branch_config == BVH_LEFT_ONLY) return CountBVH(bvh, bvh->data[index].left);
-    if (bvh->data[index].branch_config == BVH_RIGHT_ONLY) return CountBVH(bvh, bvh->data[index].right);
-    if (bvh->data[index].branch_config == BVH_BOTH) return CountBVH(bvh, bvh->data[index].left) + CountBVH(bvh, bvh->data[index].right);
-    return 0;
-}
-
-void RUTIL_BoundingVolumeHierarchy(ARRLIST_NodeBVH* bvh, ARRLIST_TriangleBB* geometry) {
-    // clear old bvh
-    ARRLIST_NodeBVH_clear(bvh);
-
-    // create root
-    NodeBVH root = {
-        { FLT_MAX, FLT_MAX, FLT_MAX },
-        { -FLT_MAX, -FLT_MAX, -FLT_MAX },
-        BVH_LEAF, 0, 0
-    };
-
-    // resize root
-    for (size_t i = 0; i < geometry->size; i++) {
-        glm_vec3_minv(root.min, geometry->data[i].min, root.min);
-        glm_vec3_maxv(root.max, geometry->data[i].max, root.max);
-    }
-
-    // add to bvh
-    ARRLIST_NodeBVH_add(bvh, root);
-
-    // set up indices
-    ARRLIST_size_t indices = { 0 };
-    for (size_t i = 0; i < geometry->size; i++) ARRLIST_size_t_add(&indices, i);
-
-    // split bvh
-    SplitBVH(bvh, 0, geometry, &indices);
-
-    // clean indices
-    ARRLIST_size_t_clear(&indices);
-}
\ No newline at end of file
+#include "rutils.h"
+#include "core/log.h"
+#include <easymemory.h>
+#include <stdio.h>
+#include <string.h>
+#define GLFW_INCLUDE_GLEXT
+#include <GLFW/glfw3.h>
+
+#define BVH_LIMIT 0.01f
+#define BVH_SAH_TRAVERSAL 1.0f
+#define BVH_SAH_INTERSECT 1.0f
+#define BVH_REPORT_EPS 0.0001f
+
+IMPL_ARRLIST(size_t);
+
+PFNGLGENBUFFERSPROC g_rutil_gen_buffers = NULL;
+PFNGLDELETEBUFFERSPROC g_rutil_delete_buffers = NULL;
+PFNGLBINDBUFFERPROC g_rutil_bind_buffer = NULL;
+PFNGLBUFFERDATAPROC g_rutil_buffer_data = NULL;
+PFNGLMAPBUFFERRANGEPROC g_rutil_map_buffer_range = NULL;
+PFNGLUNMAPBUFFERPROC g_rutil_unmap_buffer = NULL;
+
+TriangleBB RUTIL_TriangleBounds(Triangle triangle) {
+    TriangleBB bb = { 0 };
+    glm_vec3_minv(triangle.a, triangle.b, bb.min);
+    glm_vec3_minv(bb.min, triangle.c, bb.min);
+    glm_vec3_maxv(triangle.a, triangle.b, bb.max);
+    glm_vec3_maxv(bb.max, triangle.c, bb.max);
+    bb.centroid[0] = ((bb.max[0] - bb.min[0]) / 2.0f) + bb.min[0];
+    bb.centroid[1] = ((bb.max[1] - bb.min[1]) / 2.0f) + bb.min[1];
+    bb.centroid[2] = ((bb.max[2] - bb.min[2]) / 2.0f) + bb.min[2];
+    return bb;
+}
+
+void ResizeBVH(ARRLIST_NodeBVH* bvh, size_t index) {
+    if (bvh->data[index].branch_config == BVH_BOTH) {
+        ResizeBVH(bvh, bvh->data[index].left);
+        ResizeBVH(bvh, bvh->data[index].right);
+        glm_vec3_minv(
+            bvh->data[index].min,
+            bvh->data[bvh->data[index].left].min,
+            bvh->data[index].min);
+        glm_vec3_maxv(
+            bvh->data[index].max,
+            bvh->data[bvh->data[index].left].max,
+            bvh->data[index].max);
+        glm_vec3_minv(
+            bvh->data[index].min,
+            bvh->data[bvh->data[index].right].min,
+            bvh->data[index].min);
+        glm_vec3_maxv(
+            bvh->data[index].max,
+            bvh->data[bvh->data[index].right].max,
+            bvh->data[index].max);
+    } else if (bvh->data[index].branch_config == BVH_LEFT_ONLY) {
+        ResizeBVH(bvh, bvh->data[index].left);
+        glm_vec3_minv(
+            bvh->data[index].min,
+            bvh->data[bvh->data[index].left].min,
+            bvh->data[index].min);
+        glm_vec3_maxv(
+            bvh->data[index].max,
+            bvh->data[bvh->data[index].left].max,
+            bvh->data[index].max);
+    } else if (bvh->data[index].branch_config == BVH_RIGHT_ONLY) {
+        ResizeBVH(bvh, bvh->data[index].right);
+        glm_vec3_minv(
+            bvh->data[index].min,
+            bvh->data[bvh->data[index].right].min,
+            bvh->data[index].min);
+        glm_vec3_maxv(
+            bvh->data[index].max,
+            bvh->data[bvh->data[index].right].max,
+            bvh->data[index].max);
+    } else {
+        return;
+    }
+}
+
+void SplitBVH(ARRLIST_NodeBVH* bvh, size_t index, ARRLIST_TriangleBB* geometry, ARRLIST_size_t* children) {
+    #define CBVH bvh->data[index]
+    #define BVHMIN bvh->data[index].min
+    #define BVHMAX bvh->data[index].max
+    #define COPYVEC(v1, v2) { v1[0] = v2[0]; v1[1] = v2[1]; v1[2] = v2[2]; }
+
+    // set up split boxes
+    float xyz_dist[3] = {
+        BVHMAX[0] - BVHMIN[0],
+        BVHMAX[1] - BVHMIN[1],
+        BVHMAX[2] - BVHMIN[2],
+    };
+    int dist_ind = xyz_dist[0] > xyz_dist[1] ?
+        (xyz_dist[0] > xyz_dist[2] ? 0 : 2) :
+        (xyz_dist[1] > xyz_dist[2] ? 1 : 2);
+    if (xyz_dist[dist_ind] < BVH_LIMIT) {
+        size_t stream_index = index;
+        for (size_t i = 0; i < children->size; i++) {
+            NodeBVH child = {
+                { geometry->data[children->data[i]].min[0],
+                  geometry->data[children->data[i]].min[1],
+                  geometry->data[children->data[i]].min[2] },
+                { geometry->data[children->data[i]].max[0],
+                  geometry->data[children->data[i]].max[1],
+                  geometry->data[children->data[i]].max[2] },
+                BVH_LEAF, children->data[i], 0
+            };
+            ARRLIST_NodeBVH_add(bvh, child);
+            bvh->data[stream_index].left = bvh->size - 1;
+
+            if (i + 1 >= children->size) {
+                bvh->data[stream_index].branch_config = BVH_LEFT_ONLY;
+            } else {
+                bvh->data[stream_index].branch_config = BVH_BOTH;
+                NodeBVH next = {
+                    { BVHMIN[0], BVHMIN[1], BVHMIN[2] },
+                    { BVHMAX[0], BVHMAX[1], BVHMAX[2] },
+                    BVH_LEAF, 0, 0
+                };
+                ARRLIST_NodeBVH_add(bvh, next);
+                bvh->data[stream_index].right = bvh->size - 1;
+                stream_index = bvh->size - 1;
+            }
+        }
+        ResizeBVH(bvh, index);
+        return;
+    }
+    float mid_dist = xyz_dist[dist_ind] / 2.0f;
+    NodeBVH left = {
+        { BVHMIN[0], BVHMIN[1], BVHMIN[2] },
+        { BVHMAX[0], BVHMAX[1], BVHMAX[2] },
+        BVH_LEAF, 0, 0
+    };
+    NodeBVH right = {
+        { BVHMIN[0], BVHMIN[1], BVHMIN[2] },
+        { BVHMAX[0], BVHMAX[1], BVHMAX[2] },
+        BVH_LEAF, 0, 0
+    };
+    left.max[dist_ind] -= mid_dist;
+    right.min[dist_ind] += mid_dist;
+
+    // set up subchildren
+    ARRLIST_size_t left_children = { 0 };
+    ARRLIST_size_t right_children = { 0 };
+    for (size_t i = 0; i < children->size; i++) {
+        if (geometry->data[children->data[i]].centroid[dist_ind] < left.max[dist_ind])
+            ARRLIST_size_t_add(&left_children, children->data[i]);
+        else ARRLIST_size_t_add(&right_children, children->data[i]);
+    }
+    if (left_children.size > 0 && right_children.size > 0) {
+        CBVH.branch_config = BVH_BOTH;
+    } else if (left_children.size > 0) {
+        CBVH.branch_config = BVH_LEFT_ONLY;
+    } else if (right_children.size > 0) {
+        CBVH.branch_config = BVH_RIGHT_ONLY;
+    } else {
+        LOG_FATAL("This should never happen");
+        CBVH.branch_config = BVH_LEAF;
+    }
+    if (left_children.size > 1) {
+        ARRLIST_NodeBVH_add(bvh, left);
+        CBVH.left = bvh->size - 1;
+        SplitBVH(bvh, CBVH.left, geometry, &left_children);
+    } else if (left_children.size == 1) {
+        left.branch_config = BVH_LEAF;
+        left.left = left_children.data[0];
+        COPYVEC(left.min, geometry->data[left.left].min);
+        COPYVEC(left.max, geometry->data[left.left].max);
+        ARRLIST_NodeBVH_add(bvh, left);
+        CBVH.left = bvh->size - 1;
+    }
+    if (right_children.size > 1) {
+        ARRLIST_NodeBVH_add(bvh, right);
+        CBVH.right = bvh->size - 1;
+        SplitBVH(bvh, CBVH.right, geometry, &right_children);
+    } else if (right_children.size == 1) {
+        right.branch_config = BVH_LEAF;
+        right.left = right_children.data[0];
+        COPYVEC(right.min, geometry->data[right.left].min);
+        COPYVEC(right.max, geometry->data[right.left].max);
+        ARRLIST_NodeBVH_add(bvh, right);
+        CBVH.right = bvh->size - 1;
+    }
+    ARRLIST_size_t_clear(&left_children);
+    ARRLIST_size_t_clear(&right_children);
+
+    // resize
+    if (bvh->data[index].branch_config == BVH_BOTH || bvh->data[index].branch_config == BVH_LEFT_ONLY) {
+        glm_vec3_minv(
+            bvh->data[index].min,
+            bvh->data[bvh->data[index].left].min,
+            bvh->data[index].min);
+        glm_vec3_maxv(
+            bvh->data[index].max,
+            bvh->data[bvh->data[index].left].max,
+            bvh->data[index].max);
+    }
+    if (bvh->data[index].branch_config == BVH_BOTH || bvh->data[index].branch_config == BVH_RIGHT_ONLY) {
+        glm_vec3_minv(
+            bvh->data[index].min,
+            bvh->data[bvh->data[index].right].min,
+            bvh->data[index].min);
+        glm_vec3_maxv(
+            bvh->data[index].max,
+            bvh->data[bvh->data[index].right].max,
+            bvh->data[index].max);
+    }
+    
+    
+    #undef CBVH
+    #undef BVHMIN
+    #undef BVHMAX
+    #undef COPYVEC
+}
+
+size_t CountBVH(ARRLIST_NodeBVH* bvh, size_t* counts) {
+    // children are always added after their parent, so a reverse sweep sees them first
+    for (size_t i = bvh->size; i-- > 0;) {
+        NodeBVH* node = &(bvh->data[i]);
+        counts[i] = node->branch_config == BVH_LEAF ? 1 : 0;
+        BOOL has_left = node->branch_config == BVH_LEFT_ONLY || node->branch_config == BVH_BOTH;
+        BOOL has_right = node->branch_config == BVH_RIGHT_ONLY || node->branch_config == BVH_BOTH;
+        if (has_left && node->left > i && node->left < bvh->size) counts[i] += counts[node->left];
+        if (has_right && node->right > i && node->right < bvh->size) counts[i] += counts[node->right];
+    }
+    return bvh->size > 0 ? counts[0] : 0;
+}
+
+void RUTIL_BoundingVolumeHierarchy(ARRLIST_NodeBVH* bvh, ARRLIST_TriangleBB* geometry) {
+    // clear old bvh
+    ARRLIST_NodeBVH_clear(bvh);
+
+    // create root
+    NodeBVH root = {
+        { FLT_MAX, FLT_MAX, FLT_MAX },
+        { -FLT_MAX, -FLT_MAX, -FLT_MAX },
+        BVH_LEAF, 0, 0
+    };
+
+    // resize root
+    for (size_t i = 0; i < geometry->size; i++) {
+        glm_vec3_minv(root.min, geometry->data[i].min, root.min);
+        glm_vec3_maxv(root.max, geometry->data[i].max, root.max);
+    }
+
+    // add to bvh
+    ARRLIST_NodeBVH_add(bvh, root);
+
+    // set up indices
+    ARRLIST_size_t indices = { 0 };
+    for (size_t i = 0; i < geometry->size; i++) ARRLIST_size_t_add(&indices, i);
+
+    // split bvh
+    SplitBVH(bvh, 0, geometry, &indices);
+
+    // clean indices
+    ARRLIST_size_t_clear(&indices);
+}
+
+float SurfaceAreaBVH(vec3 min, vec3 max) {
+    float x = max[0] - min[0];
+    float y = max[1] - min[1];
+    float z = max[2] - min[2];
+    if (x < 0.0f || y < 0.0f || z < 0.0f) return 0.0f;
+    return 2.0f * ((x * y) + (y * z) + (z * x));
+}
+
+BOOL ContainsBVH(vec3 outer_min, vec3 outer_max, vec3 inner_min, vec3 inner_max) {
+    for (int i = 0; i < 3; i++) {
+        if (inner_min[i] < outer_min[i] - BVH_REPORT_EPS) return FALSE;
+        if (inner_max[i] > outer_max[i] + BVH_REPORT_EPS) return FALSE;
+    }
+    return TRUE;
+}
+
+BVHReport RUTIL_ReportBVH(ARRLIST_NodeBVH* bvh, ARRLIST_TriangleBB* geometry) {
+    BVHReport report = { 0 };
+    report.nodes = bvh->size;
+    report.triangles = geometry->size;
+    report.memory = bvh->size * sizeof(NodeBVH);
+    report.reserved = bvh->maxsize * sizeof(NodeBVH);
+
+    // an empty scene still builds a lone root, so there is nothing to inspect
+    if (geometry->size == 0 || bvh->size == 0) {
+        report.valid = geometry->size == 0;
+        return report;
+    }
+
+    // set up traversal
+    BOOL* visited_nodes = EZALLOC(bvh->size, sizeof(BOOL));
+    BOOL* visited_triangles = EZALLOC(geometry->size, sizeof(BOOL));
+    ARRLIST_size_t stack = { 0 };
+    ARRLIST_size_t depths = { 0 };
+    ARRLIST_size_t_add(&stack, 0);
+    ARRLIST_size_t_add(&depths, 0);
+    float root_area = SurfaceAreaBVH(bvh->data[0].min, bvh->data[0].max);
+    float depth_sum = 0.0f;
+    float sah_sum = 0.0f;
+    float overlap_sum = 0.0f;
+    size_t overlap_count = 0;
+
+    // walk the tree
+    while (stack.size > 0) {
+        size_t index = stack.data[stack.size - 1];
+        size_t depth = depths.data[depths.size - 1];
+        ARRLIST_size_t_remove(&stack, stack.size - 1);
+        ARRLIST_size_t_remove(&depths, depths.size - 1);
+        if (visited_nodes[index]) {
+            report.invalid++;
+            continue;
+        }
+        visited_nodes[index] = TRUE;
+        NodeBVH* node = &(bvh->data[index]);
+        float area = root_area > 0.0f ? SurfaceAreaBVH(node->min, node->max) / root_area : 0.0f;
+        if (depth > report.maxdepth) report.maxdepth = depth;
+
+        // leaves reference a single triangle
+        if (node->branch_config == BVH_LEAF) {
+            report.leaves++;
+            depth_sum += depth;
+            sah_sum += BVH_SAH_INTERSECT * area;
+            if (node->left >= geometry->size) {
+                report.invalid++;
+            } else if (visited_triangles[node->left]) {
+                report.duplicates++;
+            } else {
+                visited_triangles[node->left] = TRUE;
+                report.reachable++;
+                TriangleBB* bb = &(geometry->data[node->left]);
+                if (!ContainsBVH(node->min, node->max, bb->min, bb->max)) report.uncontained++;
+            }
+            continue;
+        }
+        sah_sum += BVH_SAH_TRAVERSAL * area;
+
+        // check children
+        BOOL has_left = node->branch_config == BVH_LEFT_ONLY || node->branch_config == BVH_BOTH;
+        BOOL has_right = node->branch_config == BVH_RIGHT_ONLY || node->branch_config == BVH_BOTH;
+        if (node->branch_config > BVH_BOTH ||
+            (has_left && node->left >= bvh->size) ||
+            (has_right && node->right >= bvh->size)) {
+            report.invalid++;
+            continue;
+        }
+        if (has_left) {
+            NodeBVH* child = &(bvh->data[node->left]);
+            if (!ContainsBVH(node->min, node->max, child->min, child->max)) report.uncontained++;
+            ARRLIST_size_t_add(&stack, node->left);
+            ARRLIST_size_t_add(&depths, depth + 1);
+        }
+        if (has_right) {
+            NodeBVH* child = &(bvh->data[node->right]);
+            if (!ContainsBVH(node->min, node->max, child->min, child->max)) report.uncontained++;
+            ARRLIST_size_t_add(&stack, node->right);
+            ARRLIST_size_t_add(&depths, depth + 1);
+        }
+
+        // sibling overlap relative to the parent
+        if (has_left && has_right) {
+            vec3 overlap_min, overlap_max;
+            glm_vec3_maxv(bvh->data[node->left].min, bvh->data[node->right].min, overlap_min);
+            glm_vec3_minv(bvh->data[node->left].max, bvh->data[node->right].max, overlap_max);
+            float parent_area = SurfaceAreaBVH(node->min, node->max);
+            float overlap = parent_area > 0.0f ? SurfaceAreaBVH(overlap_min, overlap_max) / parent_area : 0.0f;
+            if (overlap > report.maxoverlap) report.maxoverlap = overlap;
+            overlap_sum += overlap;
+            overlap_count++;
+        }
+    }
+
+    // bucket the number of triangles hanging off reachable nodes right above the leaves
+    size_t* counts = EZALLOC(bvh->size, sizeof(size_t));
+    CountBVH(bvh, counts);
+    for (size_t i = 0; i < bvh->size; i++) {
+        NodeBVH* node = &(bvh->data[i]);
+        if (!visited_nodes[i] || node->branch_config == BVH_LEAF) continue;
+        BOOL has_left = node->branch_config == BVH_LEFT_ONLY || node->branch_config == BVH_BOTH;
+        BOOL has_right = node->branch_config == BVH_RIGHT_ONLY || node->branch_config == BVH_BOTH;
+        BOOL leaf_parent =
+            (has_left && node->left < bvh->size && bvh->data[node->left].branch_config == BVH_LEAF) ||
+            (has_right && node->right < bvh->size && bvh->data[node->right].branch_config == BVH_LEAF);
+        if (!leaf_parent) continue;
+        size_t count = counts[i];
+        size_t bucket = 0;
+        while (count > 1 && bucket < BVH_REPORT_BUCKETS - 1) {
+            count >>= 1;
+            bucket++;
+        }
+        report.histogram[bucket]++;
+    }
+    EZFREE(counts);
+
+    // finalize
+    report.avgdepth = report.leaves > 0 ? depth_sum / report.leaves : 0.0f;
+    report.avgoverlap = overlap_count > 0 ? overlap_sum / overlap_count : 0.0f;
+    report.sahcost = sah_sum;
+    report.valid =
+        report.invalid == 0 &&
+        report.duplicates == 0 &&
+        report.uncontained == 0 &&
+        report.reachable == report.triangles;
+
+    // clean up
+    ARRLIST_size_t_clear(&stack);
+    ARRLIST_size_t_clear(&depths);
+    EZFREE(visited_nodes);
+    EZFREE(visited_triangles);
+    return report;
+}
+
+void RUTIL_PrintBVHReport(BVHReport* report) {
+    printf("Nodes:                %d (%d leaves)\n", (int)report->nodes, (int)report->leaves);
+    printf("Memory:               %d bytes (%d reserved)\n", (int)report->memory, (int)report->reserved);
+    printf("Triangles:            %d/%d reachable, %d duplicated\n", (int)report->reachable, (int)report->triangles, (int)report->duplicates);
+    printf("Depth:                %d max, %.3f average\n", (int)report->maxdepth, report->avgdepth);
+    printf("SAH cost:             %.3f\n", report->sahcost);
+    printf("Sibling overlap:      %.3f%% average, %.3f%% max\n", report->avgoverlap * 100.0f, report->maxoverlap * 100.0f);
+    printf("Leaf clusters:\n");
+    for (size_t i = 0; i < BVH_REPORT_BUCKETS; i++) {
+        if (i == 0) {
+            printf("    %4d       %d\n", 1, (int)report->histogram[i]);
+        } else if (i == BVH_REPORT_BUCKETS - 1) {
+            printf("    %4d+      %d\n", 1 << i, (int)report->histogram[i]);
+        } else {
+            printf("    %4d-%-4d  %d\n", 1 << i, (2 << i) - 1, (int)report->histogram[i]);
+        }
+    }
+    printf("Uncontained children: %d\n", (int)report->uncontained);
+    printf("Invalid references:   %d\n", (int)report->invalid);
+    printf("Validation:           %s\n", report->valid ? "passed" : "failed");
+}
+
+float RUTIL_AdaptFrameless(float frameless, float budget, float measured) {
+    if (budget <= 0.0f || measured <= 0.0f) return frameless;
+
+    // scale by how far off budget the frame was, damped so noise does not oscillate
+    float ratio = glm_clamp(budget / measured, 0.5f, 2.0f);
+    float target = glm_clamp(frameless * ratio, FRAMELESS_MIN, 1.0f);
+    return frameless + (target - frameless) * FRAMELESS_DAMPING;
+}
+
+PixelRegion RUTIL_ViewportRegion(Vector2 dimensions, Vector2 viewport) {
+    // same bounds cut_viewport keeps, an empty viewport means the whole image
+    PixelRegion region = { 0, 0, (uint32_t)dimensions.x, (uint32_t)dimensions.y };
+    if (viewport.x != 0) {
+        float lo = fmaxf(ceilf((dimensions.x - viewport.x) / 2.0f), 0.0f);
+        float hi = fminf(ceilf((dimensions.x + viewport.x) / 2.0f) + 1.0f, dimensions.x);
+        region.x = (uint32_t)lo;
+        region.width = hi > lo ? (uint32_t)(hi - lo) : 0;
+    }
+    if (viewport.y != 0) {
+        float lo = fmaxf(ceilf((dimensions.y - viewport.y) / 2.0f), 0.0f);
+        float hi = fminf(ceilf((dimensions.y + viewport.y) / 2.0f) + 1.0f, dimensions.y);
+        region.y = (uint32_t)lo;
+        region.height = hi > lo ? (uint32_t)(hi - lo) : 0;
+    }
+    return region;
+}
+
+float RUTIL_AdaptScale(RendererConfig* config, float measured) {
+    float scale = config->scale;
+    if (config->budget <= 0.0f || measured <= 0.0f) return scale;
+    float ratio = glm_clamp(config->budget / measured, 0.5f, 2.0f);
+
+    // both controllers steer on the same budget, so adaptive frameless takes the small misses
+    // and the scale only moves once the chance is pinned at the end it would have to pass
+    if (config->adaptive) {
+        if (ratio < 1.0f && config->frameless > FRAMELESS_MIN * (1.0f + RENDER_SCALE_PINNED)) return scale;
+        if (ratio > 1.0f && config->frameless < 1.0f - RENDER_SCALE_PINNED) return scale;
+    }
+
+    // every step retraces the whole image and spikes the next measurement, so ignore small misses
+    if (ratio > 1.0f / (1.0f + RENDER_SCALE_BAND) && ratio < 1.0f + RENDER_SCALE_BAND) return scale;
+
+    // cost follows pixel count, so the axis scale moves by the square root of the ratio
+    float target = scale * sqrtf(ratio);
+
+    // move a single step at a time, and only when off by more than half a step,
+    // so timing noise does not retrace the whole image every frame
+    scale = roundf(scale / RENDER_SCALE_STEP) * RENDER_SCALE_STEP;
+    if (fabsf(target - scale) > RENDER_SCALE_STEP * 0.5f)
+        scale += target > scale ? RENDER_SCALE_STEP : -RENDER_SCALE_STEP;
+    return glm_clamp(scale, RENDER_SCALE_MIN, 1.0f);
+}
+
+Vector2 RUTIL_ScaledExtent(Vector2 dimensions, float scale) {
+    scale = glm_clamp(scale, RENDER_SCALE_MIN, 1.0f);
+    return (Vector2){
+        fmaxf(floorf(dimensions.x * scale), 1.0f),
+        fmaxf(floorf(dimensions.y * scale), 1.0f) };
+}
+
+BOOL RUTIL_PixelStream(PixelStream* stream, size_t size) {
+    // buffer objects are core since gl 3.0 but raylib does not expose them
+    g_rutil_gen_buffers = (PFNGLGENBUFFERSPROC)glfwGetProcAddress("glGenBuffers");
+    g_rutil_delete_buffers = (PFNGLDELETEBUFFERSPROC)glfwGetProcAddress("glDeleteBuffers");
+    g_rutil_bind_buffer = (PFNGLBINDBUFFERPROC)glfwGetProcAddress("glBindBuffer");
+    g_rutil_buffer_data = (PFNGLBUFFERDATAPROC)glfwGetProcAddress("glBufferData");
+    g_rutil_map_buffer_range = (PFNGLMAPBUFFERRANGEPROC)glfwGetProcAddress("glMapBufferRange");
+    g_rutil_unmap_buffer = (PFNGLUNMAPBUFFERPROC)glfwGetProcAddress("glUnmapBuffer");
+    stream->ready =
+        g_rutil_gen_buffers != NULL &&
+        g_rutil_delete_buffers != NULL &&
+        g_rutil_bind_buffer != NULL &&
+        g_rutil_buffer_data != NULL &&
+        g_rutil_map_buffer_range != NULL &&
+        g_rutil_unmap_buffer != NULL;
+    stream->index = 0;
+    stream->size = size;
+    if (!stream->ready) {
+        LOG_WARN("Pixel buffer objects are not supported, falling back to synchronous uploads");
+        return FALSE;
+    }
+
+    g_rutil_gen_buffers(PIXELSTREAM_LENGTH, stream->buffers);
+    for (size_t i = 0; i < PIXELSTREAM_LENGTH; i++) {
+        g_rutil_bind_buffer(GL_PIXEL_UNPACK_BUFFER, stream->buffers[i]);
+        g_rutil_buffer_data(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+    }
+    g_rutil_bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return TRUE;
+}
+
+void RUTIL_StreamPixels(PixelStream* stream, Texture2D texture, PixelRegion region, void* pixels) {
+    if (region.width == 0 || region.height == 0) return;
+    size_t offset = ((size_t)region.y * texture.width + region.x) * 4;
+    glBindTexture(GL_TEXTURE_2D, texture.id);
+    if (!stream->ready) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, texture.width);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, region.x, region.y, region.width, region.height, GL_RGBA, GL_UNSIGNED_BYTE, (uint8_t*)pixels + offset);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return;
+    }
+
+    // rotate buffers and orphan the store, a read still pending on the old one keeps its memory
+    // and the map hands back fresh storage without stalling
+    size_t row = (size_t)region.width * 4;
+    size_t size = row * region.height;
+    stream->index = (stream->index + 1) % PIXELSTREAM_LENGTH;
+    g_rutil_bind_buffer(GL_PIXEL_UNPACK_BUFFER, stream->buffers[stream->index]);
+    g_rutil_buffer_data(GL_PIXEL_UNPACK_BUFFER, stream->size, NULL, GL_STREAM_DRAW);
+    void* mapped = g_rutil_map_buffer_range(
+        GL_PIXEL_UNPACK_BUFFER,
+        0,
+        size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped != NULL) {
+        // pack only the visible rows
+        if (region.width == (uint32_t)texture.width) {
+            memcpy(mapped, (uint8_t*)pixels + offset, size);
+        } else {
+            for (uint32_t y = 0; y < region.height; y++)
+                memcpy((uint8_t*)mapped + row * y, (uint8_t*)pixels + offset + (size_t)texture.width * 4 * y, row);
+        }
+        g_rutil_unmap_buffer(GL_PIXEL_UNPACK_BUFFER);
+
+        // sourcing from the bound buffer lets the driver copy in the background
+        glTexSubImage2D(GL_TEXTURE_2D, 0, region.x, region.y, region.width, region.height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    }
+    g_rutil_bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void RUTIL_DestroyPixelStream(PixelStream* stream) {
+    if (!stream->ready) return;
+    g_rutil_delete_buffers(PIXELSTREAM_LENGTH, stream->buffers);
+    stream->ready = FALSE;
+}
@@ -1,10 +1,30 @@
-#ifndef RUTILS_H
-#define RUTILS_H
-
-#include "renderer/rstructs.h"
-
-DECLARE_ARRLIST(size_t);
-
-void RUTIL_BoundingVolumeHierarchy(ARRLIST_NodeBVH* bvh, ARRLIST_TriangleBB* geometry);
-
+#ifndef RUTILS_H
+#define RUTILS_H
+
+#include "renderer/rstructs.h"
+
+DECLARE_ARRLIST(size_t);
+
+TriangleBB RUTIL_TriangleBounds(Triangle triangle);
+
+void RUTIL_BoundingVolumeHierarchy(ARRLIST_NodeBVH* bvh, ARRLIST_TriangleBB* geometry);
+
+BVHReport RUTIL_ReportBVH(ARRLIST_NodeBVH* bvh, ARRLIST_TriangleBB* geometry);
+
+void RUTIL_PrintBVHReport(BVHReport* report);
+
+float RUTIL_AdaptFrameless(float frameless, float budget, float measured);
+
+PixelRegion RUTIL_ViewportRegion(Vector2 dimensions, Vector2 viewport);
+
+float RUTIL_AdaptScale(RendererConfig* config, float measured);
+
+Vector2 RUTIL_ScaledExtent(Vector2 dimensions, float scale);
+
+BOOL RUTIL_PixelStream(PixelStream* stream, size_t size);
+
+void RUTIL_StreamPixels(PixelStream* stream, Texture2D texture, PixelRegion region, void* pixels);
+
+void RUTIL_DestroyPixelStream(PixelStream* stream);
+
 #endif
\ No newline at end of file
@@ -1,101 +1,229 @@
-#include "vclean.h"
-#include "renderer/vulkan/vutils.h"
-
-Renderer* g_vlcean_renderer_ref = NULL;
-
-void VCLEAN_Lights(VulkanDataBuffer* lights) {
-    VUTIL_DestroyBuffer(*lights);
-}
-
-void VCLEAN_BoundingVolumeHierarchy(VulkanDataBuffer* bvh) {
-    VUTIL_DestroyBuffer(*bvh);
-}
-
-void VCLEAN_Triangles(VulkanDataBuffer* triangles) {
-    VUTIL_DestroyBuffer(*triangles);
-}
-
-void VCLEAN_SDFs(VulkanDataBuffer* sdfs) {
-    VUTIL_DestroyBuffer(*sdfs);
-}
-
-void VCLEAN_Materials(VulkanDataBuffer* materials) {
-    VUTIL_DestroyBuffer(*materials);
-}
-
-void VCLEAN_Geometry(VulkanGeometry* geometry) {
-    VCLEAN_Triangles(&(geometry->triangles));
-    VCLEAN_Materials(&(geometry->materials));
-    VCLEAN_BoundingVolumeHierarchy(&(geometry->bvh));
-    VCLEAN_SDFs(&(geometry->sdfs));
-    VCLEAN_Lights(&(geometry->lights));
-}
-
-void VCLEAN_Metadata(VulkanMetadata* metadata) {
-    ARRLIST_StaticString_clear(&(metadata->validation));
-    ARRLIST_StaticString_clear(&(metadata->extensions.required));
-    ARRLIST_StaticString_clear(&(metadata->extensions.device));
-}
-
-void VCLEAN_General(VulkanGeneral* general) {
-    if (ENABLE_VK_VALIDATION_LAYERS) {
-        PFN_vkDestroyDebugUtilsMessengerEXT destroy_messenger = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(general->instance, "vkDestroyDebugUtilsMessengerEXT");
-        if (destroy_messenger != NULL)
-            destroy_messenger(general->instance, general->messenger, NULL);
-    }
-    vkDestroyDevice(general->interface, NULL);
-    vkDestroyInstance(general->instance, NULL);
-}
-
-void VCLEAN_RenderData(VulkanRenderData* renderdata) {
-    for (size_t i = 0; i < CPUSWAP_LENGTH; i++) {
-        VUTIL_DestroyBuffer(renderdata->ssbos[i]);
-    }
-    for (size_t i = 0; i < CPUSWAP_LENGTH; i++) {
-        VUTIL_DestroyBuffer(renderdata->ubos.objects[i]);
-    }
-    vkDestroyDescriptorPool(g_vlcean_renderer_ref->vulkan.core.general.interface, renderdata->descriptors.pool, NULL);
-    vkDestroyDescriptorSetLayout(g_vlcean_renderer_ref->vulkan.core.general.interface, renderdata->descriptors.layout, NULL);
-}
-
-void VCLEAN_RenderContext(VulkanRenderContext* context) {
-    for (size_t i = 0; i < CPUSWAP_LENGTH; i++) {
-        vkDestroyImageView(g_vlcean_renderer_ref->vulkan.core.general.interface, context->targets[i].view, NULL);
-        vkDestroyImage(g_vlcean_renderer_ref->vulkan.core.general.interface, context->targets[i].image, NULL);
-        vkFreeMemory(g_vlcean_renderer_ref->vulkan.core.general.interface, context->targets[i].memory, NULL);
-    }
-
-    VCLEAN_RenderData(&(context->renderdata));
-
-    vkDestroyPipeline(g_vlcean_renderer_ref->vulkan.core.general.interface, context->pipeline.pipeline, NULL);
-    vkDestroyPipelineLayout(g_vlcean_renderer_ref->vulkan.core.general.interface, context->pipeline.layout, NULL);
-}
-
-void VCLEAN_Bridge(VulkanDataBuffer* bridge) {
-    vkUnmapMemory(g_vlcean_renderer_ref->vulkan.core.general.interface, bridge->memory);
-    VUTIL_DestroyBuffer(*bridge);
-}
-
-void VCLEAN_Scheduler(VulkanScheduler* scheduler) {
-    for (int i = 0; i < CPUSWAP_LENGTH; i++)
-        vkDestroyFence(g_vlcean_renderer_ref->vulkan.core.general.interface, scheduler->syncro.fences[i], NULL);
-    vkDestroyCommandPool(g_vlcean_renderer_ref->vulkan.core.general.interface, scheduler->commands.pool, NULL);
-}
-
-void VCLEAN_Core(VulkanCore* core) {
-    VCLEAN_Geometry(&(core->geometry));
-    VCLEAN_Bridge(&(core->bridge));
-    VCLEAN_Scheduler(&(core->scheduler));
-    VCLEAN_RenderContext(&(core->context));
-    VCLEAN_General(&(core->general));
-}
-
-void VCLEAN_Vulkan(VulkanObject* vulkan) {
-    vkDeviceWaitIdle(g_vlcean_renderer_ref->vulkan.core.general.interface);
-    VCLEAN_Metadata(&(vulkan->metadata));
-    VCLEAN_Core(&(vulkan->core));
-}
-
-void VCLEAN_SetVulkanCleanContext(Renderer* renderer) {
-    g_vlcean_renderer_ref = renderer;
+#include "vclean.h"
+#include "renderer/vulkan/vutils.h"
+#include <easymemory.h>
+#include <stdio.h>
+
+Renderer* g_vlcean_renderer_ref = NULL;
+
+void VCLEAN_Lights(VulkanDataBuffer* lights) {
+    VUTIL_DestroyBuffer(*lights);
+}
+
+void VCLEAN_BoundingVolumeHierarchy(VulkanDataBuffer* bvh) {
+    VUTIL_DestroyBuffer(*bvh);
+}
+
+void VCLEAN_Triangles(VulkanDataBuffer* triangles) {
+    VUTIL_DestroyBuffer(*triangles);
+}
+
+void VCLEAN_SDFs(VulkanDataBuffer* sdfs) {
+    VUTIL_DestroyBuffer(*sdfs);
+}
+
+void VCLEAN_Materials(VulkanDataBuffer* materials) {
+    VUTIL_DestroyBuffer(*materials);
+}
+
+void VCLEAN_Geometry(VulkanGeometry* geometry) {
+    VCLEAN_Triangles(&(geometry->triangles));
+    VCLEAN_Materials(&(geometry->materials));
+    VCLEAN_BoundingVolumeHierarchy(&(geometry->bvh));
+    VCLEAN_SDFs(&(geometry->sdfs));
+    VCLEAN_Lights(&(geometry->lights));
+}
+
+void VCLEAN_Metadata(VulkanMetadata* metadata) {
+    ARRLIST_StaticString_clear(&(metadata->validation));
+    ARRLIST_StaticString_clear(&(metadata->extensions.required));
+    ARRLIST_StaticString_clear(&(metadata->extensions.device));
+}
+
+void VCLEAN_General(VulkanGeneral* general) {
+    if (ENABLE_VK_VALIDATION_LAYERS) {
+        PFN_vkDestroyDebugUtilsMessengerEXT destroy_messenger = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(general->instance, "vkDestroyDebugUtilsMessengerEXT");
+        if (destroy_messenger != NULL)
+            destroy_messenger(general->instance, general->messenger, NULL);
+    }
+    vkDestroyDevice(general->interface, NULL);
+    vkDestroyInstance(general->instance, NULL);
+}
+
+void VCLEAN_RenderData(VulkanRenderData* renderdata) {
+    for (size_t i = 0; i < CPUSWAP_MAX; i++) {
+        VUTIL_DestroyBuffer(renderdata->ubos.objects[i]);
+    }
+    vkDestroyDescriptorPool(g_vlcean_renderer_ref->vulkan.core.general.interface, renderdata->descriptors.pool, NULL);
+    vkDestroyDescriptorSetLayout(g_vlcean_renderer_ref->vulkan.core.general.interface, renderdata->descriptors.layout, NULL);
+}
+
+void VCLEAN_Wavefront(VulkanWavefront* wavefront) {
+    if (!wavefront->ready) return;
+    VkDevice device = g_vlcean_renderer_ref->vulkan.core.general.interface;
+    for (uint32_t i = 0; i < PIPELINE_VARIANTS; i++) {
+        WavefrontKernels* kernels = &(wavefront->variants[i]);
+        if (kernels->generate == VK_NULL_HANDLE) continue;
+        vkDestroyPipeline(device, kernels->generate, NULL);
+        vkDestroyPipeline(device, kernels->args, NULL);
+        vkDestroyPipeline(device, kernels->extend, NULL);
+        vkDestroyPipeline(device, kernels->connect, NULL);
+        vkDestroyPipeline(device, kernels->shade, NULL);
+        vkDestroyPipeline(device, kernels->resolve, NULL);
+        kernels->generate = VK_NULL_HANDLE;
+    }
+    VUTIL_DestroyBuffer(wavefront->counters);
+    VUTIL_DestroyBuffer(wavefront->queues);
+    VUTIL_DestroyBuffer(wavefront->hits);
+    VUTIL_DestroyBuffer(wavefront->visibility);
+    VUTIL_DestroyBuffer(wavefront->pixels);
+    wavefront->ready = FALSE;
+}
+
+void VCLEAN_Selection(VulkanSelection* selection) {
+    for (uint32_t i = 0; i < PIPELINE_VARIANTS; i++) {
+        if (selection->compact[i] == VK_NULL_HANDLE) continue;
+        vkDestroyPipeline(g_vlcean_renderer_ref->vulkan.core.general.interface, selection->compact[i], NULL);
+        selection->compact[i] = VK_NULL_HANDLE;
+    }
+    if (selection->select != VK_NULL_HANDLE)
+        vkDestroyPipeline(g_vlcean_renderer_ref->vulkan.core.general.interface, selection->select, NULL);
+    selection->select = VK_NULL_HANDLE;
+    VUTIL_DestroyBuffer(selection->list);
+}
+
+void VCLEAN_Reprojection(VulkanReprojection* reprojection) {
+    VkDevice device = g_vlcean_renderer_ref->vulkan.core.general.interface;
+    if (reprojection->reproject != VK_NULL_HANDLE) {
+        vkDestroyPipeline(device, reprojection->reproject, NULL);
+        vkDestroyPipeline(device, reprojection->present, NULL);
+    }
+    reprojection->reproject = VK_NULL_HANDLE;
+    reprojection->present = VK_NULL_HANDLE;
+    VulkanImage images[3] = { reprojection->history, reprojection->scratch, reprojection->keys };
+    for (size_t i = 0; i < 3; i++) {
+        VUTIL_DestroyImage(images[i]);
+    }
+}
+
+void VCLEAN_Denoiser(VulkanDenoiser* denoiser) {
+    VkDevice device = g_vlcean_renderer_ref->vulkan.core.general.interface;
+    if (denoiser->filter != VK_NULL_HANDLE) vkDestroyPipeline(device, denoiser->filter, NULL);
+    denoiser->filter = VK_NULL_HANDLE;
+    for (size_t i = 0; i < DENOISE_BINDINGS; i++) {
+        VUTIL_DestroyImage(denoiser->images[i]);
+    }
+}
+
+void VCLEAN_Interleave(VulkanInterleave* interleave) {
+    VkDevice device = g_vlcean_renderer_ref->vulkan.core.general.interface;
+    if (interleave->reconstruct != VK_NULL_HANDLE) vkDestroyPipeline(device, interleave->reconstruct, NULL);
+    interleave->reconstruct = VK_NULL_HANDLE;
+    VUTIL_DestroyImage(interleave->lattice);
+}
+
+void VCLEAN_PipelineCache(VkPipelineCache cache) {
+    VkDevice device = g_vlcean_renderer_ref->vulkan.core.general.interface;
+    size_t size = 0;
+    vkGetPipelineCacheData(device, cache, &size, NULL);
+    unsigned char* blob = EZALLOC(sizeof(PipelineCacheHeader) + size, sizeof(unsigned char));
+    if (vkGetPipelineCacheData(device, cache, &size, blob + sizeof(PipelineCacheHeader)) == VK_SUCCESS) {
+        PipelineCacheHeader header = VUTIL_PipelineCacheHeader();
+        header.size = size;
+        header.checksum = VUTIL_Hash(blob + sizeof(PipelineCacheHeader), size, PIPELINE_CACHE_SEED);
+        memcpy(blob, &header, sizeof(PipelineCacheHeader));
+
+        // write next to the old cache and swap so a crash never leaves half a file
+        MakeDirectory(PIPELINE_CACHE_DIRECTORY);
+        if (SaveFileData(PIPELINE_CACHE_PATH ".tmp", blob, (int)(sizeof(PipelineCacheHeader) + size))) {
+            remove(PIPELINE_CACHE_PATH);
+            rename(PIPELINE_CACHE_PATH ".tmp", PIPELINE_CACHE_PATH);
+        }
+    }
+    EZFREE(blob);
+    vkDestroyPipelineCache(device, cache, NULL);
+}
+
+void VCLEAN_RenderContext(VulkanRenderContext* context) {
+    for (size_t i = 0; i < context->slots; i++) {
+        VUTIL_DestroyImage(context->targets[i]);
+        VUTIL_DestroyBuffer(context->bridges[i]);
+    }
+
+    for (size_t i = 0; i < context->slots; i++) {
+        VUTIL_DestroyImage(context->accumulation.images[i]);
+    }
+
+    for (size_t i = 0; i < context->slots; i++) {
+        VUTIL_DestroyImage(context->renderdata.ages[i]);
+        VUTIL_DestroyImage(context->renderdata.variances[i]);
+    }
+    context->slots = 0;
+
+    VCLEAN_Wavefront(&(context->wavefront));
+    VCLEAN_Selection(&(context->selection));
+    VCLEAN_Reprojection(&(context->reprojection));
+    VCLEAN_Denoiser(&(context->denoiser));
+    VCLEAN_Interleave(&(context->interleave));
+    VCLEAN_RenderData(&(context->renderdata));
+
+    for (uint32_t i = 0; i < PIPELINE_VARIANTS; i++) {
+        if (context->pipeline.variants[i] == VK_NULL_HANDLE) continue;
+        vkDestroyPipeline(g_vlcean_renderer_ref->vulkan.core.general.interface, context->pipeline.variants[i], NULL);
+        context->pipeline.variants[i] = VK_NULL_HANDLE;
+    }
+    vkDestroyPipeline(g_vlcean_renderer_ref->vulkan.core.general.interface, context->pipeline.resolve, NULL);
+    VCLEAN_PipelineCache(context->pipeline.cache);
+    vkDestroyPipelineLayout(g_vlcean_renderer_ref->vulkan.core.general.interface, context->pipeline.layout, NULL);
+}
+
+void VCLEAN_Transfer(VulkanTransfer* transfer) {
+    if (!transfer->dedicated) return;
+    for (size_t i = 0; i < CPUSWAP_MAX; i++) {
+        VUTIL_RecycleTransfers(i);
+        ARRLIST_VkBuffer_clear(&(transfer->acquires[i]));
+        for (size_t j = 0; j < TRANSFER_BATCHES; j++) {
+            vkDestroySemaphore(g_vlcean_renderer_ref->vulkan.core.general.interface, transfer->semaphores[i][j], NULL);
+            vkDestroySemaphore(g_vlcean_renderer_ref->vulkan.core.general.interface, transfer->drained[i][j], NULL);
+        }
+    }
+    vkDestroyCommandPool(g_vlcean_renderer_ref->vulkan.core.general.interface, transfer->pool, NULL);
+    transfer->dedicated = FALSE;
+}
+
+void VCLEAN_Scheduler(VulkanScheduler* scheduler) {
+    VCLEAN_Transfer(&(scheduler->transfer));
+    for (int i = 0; i < CPUSWAP_MAX; i++)
+        vkDestroyFence(g_vlcean_renderer_ref->vulkan.core.general.interface, scheduler->syncro.fences[i], NULL);
+    for (int i = 0; i < CPUSWAP_MAX && scheduler->timestamps.ready; i++)
+        vkDestroyQueryPool(g_vlcean_renderer_ref->vulkan.core.general.interface, scheduler->timestamps.pools[i], NULL);
+    vkDestroyCommandPool(g_vlcean_renderer_ref->vulkan.core.general.interface, scheduler->commands.pool, NULL);
+}
+
+void VCLEAN_Memory(VulkanMemory* memory) {
+    for (uint32_t i = 0; i < VK_MAX_MEMORY_TYPES; i++) {
+        for (uint32_t j = 0; j < MEMORY_STRATEGIES; j++) {
+            ARRLIST_VulkanMemoryBlock* blocks = &(memory->pools[i].blocks[j]);
+            for (size_t k = 0; k < blocks->size; k++)
+                if (blocks->data[k].memory != VK_NULL_HANDLE) VUTIL_ReleaseBlock(&(blocks->data[k]));
+            ARRLIST_VulkanMemoryBlock_clear(blocks);
+        }
+    }
+}
+
+void VCLEAN_Core(VulkanCore* core) {
+    VCLEAN_Geometry(&(core->geometry));
+    VCLEAN_Scheduler(&(core->scheduler));
+    VCLEAN_RenderContext(&(core->context));
+    VCLEAN_Memory(&(core->memory));
+    VCLEAN_General(&(core->general));
+}
+
+void VCLEAN_Vulkan(VulkanObject* vulkan) {
+    vkDeviceWaitIdle(g_vlcean_renderer_ref->vulkan.core.general.interface);
+    VCLEAN_Metadata(&(vulkan->metadata));
+    VCLEAN_Core(&(vulkan->core));
+}
+
+void VCLEAN_SetVulkanCleanContext(Renderer* renderer) {
+    g_vlcean_renderer_ref = renderer;
 }
\ No newline at end of file
@@ -1,36 +1,48 @@
-#ifndef VCLEAN_H
-#define VCLEAN_H
-
-#include "renderer/vulkan/vstructs.h"
-
-void VCLEAN_Lights(VulkanDataBuffer* lights);
-
-void VCLEAN_BoundingVolumeHierarchy(VulkanDataBuffer* bvh);
-
-void VCLEAN_Triangles(VulkanDataBuffer* triangles);
-
-void VCLEAN_SDFs(VulkanDataBuffer* sdfs);
-
-void VCLEAN_Materials(VulkanDataBuffer* materials);
-
-void VCLEAN_Geometry(VulkanGeometry* geometry);
-
-void VCLEAN_Metadata(VulkanMetadata* metadata);
-
-void VCLEAN_General(VulkanGeneral* general);
-
-void VCLEAN_RenderData(VulkanRenderData* renderdata);
-
-void VCLEAN_RenderContext(VulkanRenderContext* context);
-
-void VCLEAN_Bridge(VulkanDataBuffer* bridge);
-
-void VCLEAN_Scheduler(VulkanScheduler* scheduler);
-
-void VCLEAN_Core(VulkanCore* core);
-
-void VCLEAN_Vulkan(VulkanObject* vulkan);
-
-void VCLEAN_SetVulkanCleanContext(Renderer* renderer);
-
+#ifndef VCLEAN_H
+#define VCLEAN_H
+
+#include "renderer/vulkan/vstructs.h"
+
+void VCLEAN_Lights(VulkanDataBuffer* lights);
+
+void VCLEAN_BoundingVolumeHierarchy(VulkanDataBuffer* bvh);
+
+void VCLEAN_Triangles(VulkanDataBuffer* triangles);
+
+void VCLEAN_SDFs(VulkanDataBuffer* sdfs);
+
+void VCLEAN_Materials(VulkanDataBuffer* materials);
+
+void VCLEAN_Geometry(VulkanGeometry* geometry);
+
+void VCLEAN_Metadata(VulkanMetadata* metadata);
+
+void VCLEAN_General(VulkanGeneral* general);
+
+void VCLEAN_RenderData(VulkanRenderData* renderdata);
+
+void VCLEAN_Wavefront(VulkanWavefront* wavefront);
+
+void VCLEAN_Selection(VulkanSelection* selection);
+void VCLEAN_Reprojection(VulkanReprojection* reprojection);
+void VCLEAN_Denoiser(VulkanDenoiser* denoiser);
+void VCLEAN_Interleave(VulkanInterleave* interleave);
+
+void VCLEAN_PipelineCache(VkPipelineCache cache);
+
+void VCLEAN_RenderContext(VulkanRenderContext* context);
+
+
+void VCLEAN_Transfer(VulkanTransfer* transfer);
+
+void VCLEAN_Scheduler(VulkanScheduler* scheduler);
+
+void VCLEAN_Memory(VulkanMemory* memory);
+
+void VCLEAN_Core(VulkanCore* core);
+
+void VCLEAN_Vulkan(VulkanObject* vulkan);
+
+void VCLEAN_SetVulkanCleanContext(Renderer* renderer);
+
 #endif
\ No newline at end of file
@@ -1,15 +1,64 @@
-#ifndef VCONFIG_H
-#define VCONFIG_H
-
-#define CPUSWAP_LENGTH 2
-#define IMAGE_FORMAT VK_FORMAT_R8G8B8A8_SRGB
-#define INVOCATION_GROUP_SIZE 256
-#define FRAMELESS_CHANCE 1.0f
-
-#ifdef PROD_BUILD
-    #define ENABLE_VK_VALIDATION_LAYERS FALSE
-#else
-    #define ENABLE_VK_VALIDATION_LAYERS TRUE
-#endif
-
-#endif
+#ifndef VCONFIG_H
+#define VCONFIG_H
+
+#define CPUSWAP_MAX 4
+#define CPUSWAP_MIN 2
+#define CPUSWAP_DEFAULT 2
+#define PIXELSTREAM_LENGTH 3
+#define IMAGE_FORMAT VK_FORMAT_R8G8B8A8_SRGB
+#define INVOCATION_TILE_WIDTH 8
+#define INVOCATION_TILE_HEIGHT 8
+#define FRAMELESS_CHANCE 1.0f
+#define FRAMELESS_BUDGET 12.0f
+#define FRAMELESS_DAMPING 0.2f
+#define FRAMELESS_MIN 0.001f
+#define RENDER_SCALE_MIN 0.25f
+#define RENDER_SCALE_STEP 0.0625f
+#define RENDER_SCALE_BAND 0.25f
+#define RENDER_SCALE_PINNED 0.05f
+#define RETRACE_AGE 1000000.0f
+#define AGE_FORMAT VK_FORMAT_R32_SFLOAT
+#define VARIANCE_FORMAT VK_FORMAT_R16G16B16A16_SFLOAT
+#define WAVEFRONT_QUEUES 2
+#define WAVEFRONT_FIRST_BINDING 8
+#define WAVEFRONT_BINDINGS 5
+#define ACCUMULATION_FORMAT VK_FORMAT_R32G32B32A32_SFLOAT
+#define ACCUMULATION_BINDING 13
+#define SELECTION_BINDING 14
+#define VARIANCE_BINDING 15
+#define HISTORY_FORMAT VK_FORMAT_R32G32B32A32_SFLOAT
+#define DEPTHKEY_FORMAT VK_FORMAT_R32_UINT
+#define REPROJECTION_FIRST_BINDING 16
+#define REPROJECTION_BINDINGS 3
+#define DENOISE_FORMAT VK_FORMAT_R16G16B16A16_SFLOAT
+#define DENOISE_FIRST_BINDING 19
+#define DENOISE_BINDINGS 4
+#define DENOISE_ITERATIONS 4
+#define INTERLEAVE_FORMAT VK_FORMAT_R16G16B16A16_SFLOAT
+#define INTERLEAVE_BINDING 23
+#define DESCRIPTOR_BINDINGS 24
+#define PIPELINE_FEATURES 6
+#define PIPELINE_VARIANTS (1 << PIPELINE_FEATURES)
+#define PIPELINE_CACHE_DIRECTORY "build/cache"
+#define PIPELINE_CACHE_PATH "build/cache/pipelines.bin"
+#define PIPELINE_CACHE_MAGIC 0x48435350
+#define PIPELINE_CACHE_VERSION 1
+#define PIPELINE_CACHE_SEED 0xcbf29ce484222325ULL
+#define TIMESTAMP_DISPATCH 0
+#define TIMESTAMP_COPY 1
+#define TIMESTAMP_END 2
+#define TIMESTAMP_UPLOADS 3
+#define TIMESTAMP_MAX_UPLOADS 8
+#define TIMESTAMP_QUERIES (TIMESTAMP_UPLOADS + 2 * TIMESTAMP_MAX_UPLOADS)
+#define TRANSFER_BATCHES 8
+#define MEMORY_BLOCK_SIZE (64ULL << 20)
+#define MEMORY_LINEAR_BLOCK_SIZE (16ULL << 20)
+#define MEMORY_BUDDY_LEAF 4096ULL
+
+#ifdef PROD_BUILD
+    #define ENABLE_VK_VALIDATION_LAYERS FALSE
+#else
+    #define ENABLE_VK_VALIDATION_LAYERS TRUE
+#endif
+
+#endif
@@ -3,6 +3,7 @@
 #include "renderer/vulkan/vutils.h"
 #include "renderer/vulkan/vupdate.h"
 #include <GLFW/glfw3.h>
+#include <stddef.h>
 
 Renderer* g_vinit_renderer_ref = NULL;
 
@@ -13,6 +14,7 @@ BOOL VINIT_Lights(VulkanDataBuffer* lights) {
         arrsize,
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        MEMORY_BUDDY,
         lights);
     VUPDT_Lights(lights);
     return TRUE;
@@ -28,6 +30,68 @@ BOOL VINIT_Queue(VkQueue* queue) {
     return TRUE;
 }
 
+BOOL VINIT_Transfer(VulkanTransfer* transfer) {
+    // without a separate family uploads stay synchronous on the compute queue
+    VulkanFamilyGroup families = VUTIL_FindQueueFamilies(g_vinit_renderer_ref->vulkan.core.general.gpu);
+    transfer->dedicated = FALSE;
+    if (!families.transfer.exists) {
+        LOG_INFO("No separate transfer queue family, uploads share the compute queue");
+        return TRUE;
+    }
+    transfer->family = families.transfer.value;
+    transfer->owner = families.graphics.value;
+    vkGetDeviceQueue(g_vinit_renderer_ref->vulkan.core.general.interface, transfer->family, 0, &(transfer->queue));
+
+    // create command pool and a batch per swap
+    VkCommandPoolCreateInfo poolInfo = { 0 };
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = transfer->family;
+    VkResult result = vkCreateCommandPool(
+		g_vinit_renderer_ref->vulkan.core.general.interface,
+		&poolInfo, NULL, &(transfer->pool));
+    if (result != VK_SUCCESS) {
+		LOG_FATAL("Failed to create transfer command pool!");
+		return FALSE;
+	}
+	VkCommandBufferAllocateInfo allocInfo = { 0 };
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = transfer->pool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = CPUSWAP_MAX * TRANSFER_BATCHES;
+    result = vkAllocateCommandBuffers(
+		g_vinit_renderer_ref->vulkan.core.general.interface,
+		&allocInfo,
+		transfer->commands[0]);
+    if (result != VK_SUCCESS) {
+		LOG_FATAL("Failed to create transfer command buffers");
+		return FALSE;
+	}
+
+    // the dispatch of the same swap waits on its batches, each batch on the dispatches before it
+    VkSemaphoreCreateInfo semaphoreInfo = { 0 };
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    for (size_t i = 0; i < CPUSWAP_MAX; i++) {
+        for (size_t j = 0; j < TRANSFER_BATCHES; j++) {
+            result = vkCreateSemaphore(
+                g_vinit_renderer_ref->vulkan.core.general.interface,
+                &semaphoreInfo, NULL, &(transfer->semaphores[i][j]));
+            if (result == VK_SUCCESS) result = vkCreateSemaphore(
+                g_vinit_renderer_ref->vulkan.core.general.interface,
+                &semaphoreInfo, NULL, &(transfer->drained[i][j]));
+            if (result != VK_SUCCESS) {
+                LOG_FATAL("Failed to create transfer semaphore");
+                return FALSE;
+            }
+        }
+        transfer->batches[i] = 0;
+        transfer->recording[i] = FALSE;
+    }
+    transfer->dedicated = TRUE;
+    LOG_INFO("Uploading on queue family %d", (int)transfer->family);
+    return TRUE;
+}
+
 BOOL VINIT_Commands(VulkanCommands* commands) {
 	// create command pool
     VulkanFamilyGroup queueFamilyIndices = VUTIL_FindQueueFamilies(g_vinit_renderer_ref->vulkan.core.general.gpu);
@@ -48,7 +112,7 @@ BOOL VINIT_Commands(VulkanCommands* commands) {
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.commandPool = commands->pool;
     allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = CPUSWAP_LENGTH;
+    allocInfo.commandBufferCount = CPUSWAP_MAX;
     result = vkAllocateCommandBuffers(
 		g_vinit_renderer_ref->vulkan.core.general.interface,
 		&allocInfo,
@@ -62,7 +126,7 @@ BOOL VINIT_Commands(VulkanCommands* commands) {
 }
 
 BOOL VINIT_Syncro(VulkanSyncro* syncro) {
-	for (int i = 0; i < CPUSWAP_LENGTH; i++) {
+	for (int i = 0; i < CPUSWAP_MAX; i++) {
         VkFenceCreateInfo fenceInfo = { 0 };
         fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
         if (i != 0) fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
@@ -79,17 +143,15 @@ BOOL VINIT_Syncro(VulkanSyncro* syncro) {
 
 BOOL VINIT_UniformBuffers(UBOArray* ubos) {
     VkDeviceSize size = sizeof(UniformBufferObject);
-    for (size_t i = 0; i < CPUSWAP_LENGTH; i++) {
+    for (size_t i = 0; i < CPUSWAP_MAX; i++) {
         VUTIL_CreateBuffer(
             size,
             VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            MEMORY_BUDDY,
             &(ubos->objects[i]));
-
-        vkMapMemory(
-            g_vinit_renderer_ref->vulkan.core.general.interface,
-            ubos->objects[i].memory,
-            0, size, 0, &(ubos->mapped[i]));
+        ubos->mapped[i] = ubos->objects[i].allocation.mapped;
+        memset(&(ubos->contents[i]), 0, sizeof(UniformBufferObject));
     }
     return TRUE;
 }
@@ -102,11 +164,11 @@ BOOL VINIT_Descriptors(VulkanDescriptors* descriptors) {
     uboLayoutBinding.descriptorCount = 1;
     uboLayoutBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
 
-    VkDescriptorSetLayoutBinding ssboLayoutBinding = { 0 };
-    ssboLayoutBinding.binding = 1;
-    ssboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    ssboLayoutBinding.descriptorCount = 1;
-    ssboLayoutBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    VkDescriptorSetLayoutBinding ageLayoutBinding = { 0 };
+    ageLayoutBinding.binding = 1;
+    ageLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    ageLayoutBinding.descriptorCount = 1;
+    ageLayoutBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
 
     VkDescriptorSetLayoutBinding imageLayoutBinding = { 0 };
     imageLayoutBinding.binding = 2;
@@ -144,9 +206,27 @@ BOOL VINIT_Descriptors(VulkanDescriptors* descriptors) {
     lightLayoutBinding.descriptorCount = 1;
     lightLayoutBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
 
-    VkDescriptorSetLayoutBinding bindings[] = { 
+    VkDescriptorSetLayoutBinding selectionLayoutBinding = { 0 };
+    selectionLayoutBinding.binding = SELECTION_BINDING;
+    selectionLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    selectionLayoutBinding.descriptorCount = 1;
+    selectionLayoutBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkDescriptorSetLayoutBinding varianceLayoutBinding = { 0 };
+    varianceLayoutBinding.binding = VARIANCE_BINDING;
+    varianceLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    varianceLayoutBinding.descriptorCount = 1;
+    varianceLayoutBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkDescriptorSetLayoutBinding accumulationLayoutBinding = { 0 };
+    accumulationLayoutBinding.binding = ACCUMULATION_BINDING;
+    accumulationLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    accumulationLayoutBinding.descriptorCount = 1;
+    accumulationLayoutBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkDescriptorSetLayoutBinding bindings[DESCRIPTOR_BINDINGS] = { 
         uboLayoutBinding,
-        ssboLayoutBinding,
+        ageLayoutBinding,
         imageLayoutBinding,
         trianglesLayoutBinding,
         materialsLayoutBinding,
@@ -155,9 +235,28 @@ BOOL VINIT_Descriptors(VulkanDescriptors* descriptors) {
         lightLayoutBinding
     };
 
+    // wavefront queues, only written once wavefront mode is first enabled
+    for (uint32_t i = WAVEFRONT_FIRST_BINDING; i < WAVEFRONT_FIRST_BINDING + WAVEFRONT_BINDINGS; i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+    bindings[ACCUMULATION_BINDING] = accumulationLayoutBinding;
+    bindings[SELECTION_BINDING] = selectionLayoutBinding;
+    bindings[VARIANCE_BINDING] = varianceLayoutBinding;
+
+    // reprojection, denoiser and interleave images are shared by every swap
+    for (uint32_t i = REPROJECTION_FIRST_BINDING; i <= INTERLEAVE_BINDING; i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
     VkDescriptorSetLayoutCreateInfo layoutInfo = { 0 };
     layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    layoutInfo.bindingCount = 8;
+    layoutInfo.bindingCount = DESCRIPTOR_BINDINGS;
     layoutInfo.pBindings = bindings;
 
     VkResult result = vkCreateDescriptorSetLayout(
@@ -171,27 +270,27 @@ BOOL VINIT_Descriptors(VulkanDescriptors* descriptors) {
     // create descriptor pool
     VkDescriptorPoolSize poolSizes[8] = { 0 };
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = CPUSWAP_LENGTH;
-    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    poolSizes[1].descriptorCount = CPUSWAP_LENGTH;
+    poolSizes[0].descriptorCount = CPUSWAP_MAX;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    poolSizes[1].descriptorCount = CPUSWAP_MAX;
     poolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-    poolSizes[2].descriptorCount = CPUSWAP_LENGTH;
+    poolSizes[2].descriptorCount = CPUSWAP_MAX * (4 + REPROJECTION_BINDINGS + DENOISE_BINDINGS);
     poolSizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    poolSizes[3].descriptorCount = CPUSWAP_LENGTH;
+    poolSizes[3].descriptorCount = CPUSWAP_MAX;
     poolSizes[4].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    poolSizes[4].descriptorCount = CPUSWAP_LENGTH;
+    poolSizes[4].descriptorCount = CPUSWAP_MAX;
     poolSizes[5].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    poolSizes[5].descriptorCount = CPUSWAP_LENGTH;
+    poolSizes[5].descriptorCount = CPUSWAP_MAX;
     poolSizes[6].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    poolSizes[6].descriptorCount = CPUSWAP_LENGTH;
+    poolSizes[6].descriptorCount = CPUSWAP_MAX;
     poolSizes[7].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    poolSizes[7].descriptorCount = CPUSWAP_LENGTH;
+    poolSizes[7].descriptorCount = CPUSWAP_MAX * (2 + WAVEFRONT_BINDINGS);
 
     VkDescriptorPoolCreateInfo poolInfo = { 0 };
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = 8;
     poolInfo.pPoolSizes = poolSizes;
-    poolInfo.maxSets = CPUSWAP_LENGTH;
+    poolInfo.maxSets = CPUSWAP_MAX;
     result = vkCreateDescriptorPool(
         g_vinit_renderer_ref->vulkan.core.general.interface,
         &poolInfo, NULL, &(descriptors->pool));
@@ -201,12 +300,12 @@ BOOL VINIT_Descriptors(VulkanDescriptors* descriptors) {
     }
 
     // create descriptor sets
-    VkDescriptorSetLayout layouts[CPUSWAP_LENGTH];
-    for (size_t i = 0; i < CPUSWAP_LENGTH; i++) layouts[i] = descriptors->layout;
+    VkDescriptorSetLayout layouts[CPUSWAP_MAX];
+    for (size_t i = 0; i < CPUSWAP_MAX; i++) layouts[i] = descriptors->layout;
     VkDescriptorSetAllocateInfo allocInfo = { 0 };
     allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocInfo.descriptorPool = descriptors->pool;
-    allocInfo.descriptorSetCount = CPUSWAP_LENGTH;
+    allocInfo.descriptorSetCount = CPUSWAP_MAX;
     allocInfo.pSetLayouts = layouts;
     result = vkAllocateDescriptorSets(
         g_vinit_renderer_ref->vulkan.core.general.interface,
@@ -220,54 +319,65 @@ BOOL VINIT_Descriptors(VulkanDescriptors* descriptors) {
     return TRUE;
 }
 
-BOOL VINIT_ShaderStorageBuffers(VulkanDataBuffer* ssbo_array) {
-    uint32_t imgw = (uint32_t)g_vinit_renderer_ref->dimensions.x;
-    uint32_t imgh = (uint32_t)g_vinit_renderer_ref->dimensions.y;
-    RayGenerator* raygens = EZALLOC(imgw * imgh, sizeof(RayGenerator));
-    for (uint32_t x = 0; x < imgw; x++) {
-        for (uint32_t y = 0; y < imgh; y++) {
-            raygens[y*imgw + x].x = x;
-            raygens[y*imgw + x].y = y;
-			raygens[y*imgw + x].time = 0.0f;
-        }
-    }
-
-    VkDeviceSize bufferSize = sizeof(RayGenerator) * imgw * imgh;
-    VulkanDataBuffer stagingBuffer;
-    VUTIL_CreateBuffer(
-        bufferSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        &stagingBuffer);
-    void* data;
-    vkMapMemory(g_vinit_renderer_ref->vulkan.core.general.interface, stagingBuffer.memory, 0, bufferSize, 0, &data);
-    memcpy(data, raygens, (size_t)bufferSize);
-    vkUnmapMemory(g_vinit_renderer_ref->vulkan.core.general.interface, stagingBuffer.memory);
-
-    for (size_t i = 0; i < CPUSWAP_LENGTH; i++) {
-        VUTIL_CreateBuffer(
-            bufferSize,
-            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+BOOL VINIT_PixelImages(VulkanImage* images, size_t count, VkFormat format) {
+    // per pixel state starts at zero, cleared on the device so no staging upload is needed
+    for (size_t i = 0; i < count; i++) {
+        VUTIL_CreateImage(
+            g_vinit_renderer_ref->dimensions.x,
+            g_vinit_renderer_ref->dimensions.y,
+            1,
+            VK_SAMPLE_COUNT_1_BIT,
+            format,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            &(ssbo_array[i]));
-        VUTIL_CopyBuffer(stagingBuffer.buffer, ssbo_array[i].buffer, bufferSize);
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            &(images[i]));
+        VUTIL_TransitionImageLayout(
+            images[i].image,
+            format,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_GENERAL,
+            1);
+        VkCommandBuffer command = VUTIL_BeginSingleTimeCommands();
+        VkClearColorValue clear = { 0 };
+        VkImageSubresourceRange range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        vkCmdClearColorImage(command, images[i].image, VK_IMAGE_LAYOUT_GENERAL, &clear, 1, &range);
+        VUTIL_EndSingleTimeCommands(command);
     }
-
-    vkDestroyBuffer(g_vinit_renderer_ref->vulkan.core.general.interface, stagingBuffer.buffer, NULL);
-    vkFreeMemory(g_vinit_renderer_ref->vulkan.core.general.interface, stagingBuffer.memory, NULL);
-    EZFREE(raygens);
     return TRUE;
 }
 
 BOOL VINIT_RenderData(VulkanRenderData* renderdata) {
-	if (!VINIT_ShaderStorageBuffers(renderdata->ssbos)) return FALSE;
 	if (!VINIT_UniformBuffers(&(renderdata->ubos))) return FALSE;
 	if (!VINIT_Descriptors(&(renderdata->descriptors))) return FALSE;
     return TRUE;
 }
 
-BOOL VINIT_Pipeline(VulkanPipeline* pipeline) {
-    SimpleFile* compshadercode = ReadFile("build/shaders/shader.comp.spv");
+void VINIT_Specialization(uint32_t variant, PipelineSpecialization* data, VkSpecializationMapEntry* entries, VkSpecializationInfo* info) {
+    // tile shape and feature toggles are fed to the shader as specialization constants
+    data->width = g_vinit_renderer_ref->vulkan.core.context.pipeline.tile.width;
+    data->height = g_vinit_renderer_ref->vulkan.core.context.pipeline.tile.height;
+    entries[0].constantID = 0;
+    entries[0].offset = offsetof(PipelineSpecialization, width);
+    entries[0].size = sizeof(uint32_t);
+    entries[1].constantID = 1;
+    entries[1].offset = offsetof(PipelineSpecialization, height);
+    entries[1].size = sizeof(uint32_t);
+    for (uint32_t i = 0; i < PIPELINE_FEATURES; i++) {
+        data->features[i] = (variant >> i) & 1 ? VK_TRUE : VK_FALSE;
+        entries[2 + i].constantID = 2 + i;
+        entries[2 + i].offset = offsetof(PipelineSpecialization, features) + sizeof(VkBool32) * i;
+        entries[2 + i].size = sizeof(VkBool32);
+    }
+    info->mapEntryCount = 2 + PIPELINE_FEATURES;
+    info->pMapEntries = entries;
+    info->dataSize = sizeof(PipelineSpecialization);
+    info->pData = data;
+}
+
+BOOL VINIT_ComputePipeline(const char* path, VkPipelineLayout layout, VkSpecializationInfo* specialization, VkPipeline* pipeline) {
+    SimpleFile* compshadercode = ReadFile(path);
 	VkShaderModule compshader = VUTIL_CreateShader(compshadercode);
 
 	VkPipelineShaderStageCreateInfo compShaderStageInfo = { 0 };
@@ -275,11 +385,83 @@ BOOL VINIT_Pipeline(VulkanPipeline* pipeline) {
 	compShaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
 	compShaderStageInfo.module = compshader;
 	compShaderStageInfo.pName = "main";
+    compShaderStageInfo.pSpecializationInfo = specialization;
+
+    VkComputePipelineCreateInfo pipelineInfo = { 0 };
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.layout = layout;
+    pipelineInfo.stage = compShaderStageInfo;
+
+    VkResult result = vkCreateComputePipelines(
+        g_vinit_renderer_ref->vulkan.core.general.interface,
+        g_vinit_renderer_ref->vulkan.core.context.pipeline.cache, 1, &pipelineInfo, NULL, pipeline);
+
+    FreeFile(compshadercode);
+	vkDestroyShaderModule(g_vinit_renderer_ref->vulkan.core.general.interface, compshader, NULL);
+    if (result != VK_SUCCESS) {
+        LOG_FATAL("Failed to create pipeline %s!", path);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+BOOL VINIT_PipelineCache(VkPipelineCache* cache) {
+    // only reuse a cache written by this driver for these exact shaders
+    PipelineCacheHeader expected = VUTIL_PipelineCacheHeader();
+    int filesize = 0;
+    unsigned char* file = FileExists(PIPELINE_CACHE_PATH) ? LoadFileData(PIPELINE_CACHE_PATH, &filesize) : NULL;
+    VkPipelineCacheCreateInfo cacheInfo = { 0 };
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    if (file != NULL && (size_t)filesize >= sizeof(PipelineCacheHeader)) {
+        PipelineCacheHeader header;
+        memcpy(&header, file, sizeof(PipelineCacheHeader));
+        expected.size = header.size;
+        expected.checksum = header.checksum;
+        if (memcmp(&header, &expected, sizeof(PipelineCacheHeader)) == 0 &&
+            header.size == (size_t)filesize - sizeof(PipelineCacheHeader) &&
+            VUTIL_Hash(file + sizeof(PipelineCacheHeader), header.size, PIPELINE_CACHE_SEED) == header.checksum) {
+            cacheInfo.initialDataSize = header.size;
+            cacheInfo.pInitialData = file + sizeof(PipelineCacheHeader);
+        } else {
+            LOG_INFO("Discarding stale pipeline cache");
+        }
+    }
+
+    VkResult result = vkCreatePipelineCache(g_vinit_renderer_ref->vulkan.core.general.interface, &cacheInfo, NULL, cache);
+    if (file != NULL) UnloadFileData(file);
+    if (result != VK_SUCCESS) {
+        LOG_FATAL("Failed to create pipeline cache!");
+        return FALSE;
+    }
+    return TRUE;
+}
+
+BOOL VINIT_Pipeline(VulkanPipeline* pipeline) {
+    if (!VINIT_PipelineCache(&(pipeline->cache))) return FALSE;
+
+    // pick the workgroup tile, falling back if the device cannot fit it
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(g_vinit_renderer_ref->vulkan.core.general.gpu, &properties);
+    pipeline->tile = (VkExtent2D){ INVOCATION_TILE_WIDTH, INVOCATION_TILE_HEIGHT };
+    if (pipeline->tile.width > properties.limits.maxComputeWorkGroupSize[0] ||
+        pipeline->tile.height > properties.limits.maxComputeWorkGroupSize[1] ||
+        pipeline->tile.width * pipeline->tile.height > properties.limits.maxComputeWorkGroupInvocations) {
+        LOG_WARN("Tile %dx%d does not fit in a workgroup, using 8x8", (int)pipeline->tile.width, (int)pipeline->tile.height);
+        pipeline->tile = (VkExtent2D){ 8, 8 };
+    }
+
+    // per frame values go through push constants, shared by every kernel
+    VkPushConstantRange pushRange = { 0 };
+    pushRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushRange.offset = 0;
+    pushRange.size = sizeof(FramePushConstants);
 
     VkPipelineLayoutCreateInfo pipelineLayoutInfo = { 0 };
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipelineLayoutInfo.setLayoutCount = 1;
     pipelineLayoutInfo.pSetLayouts = &(g_vinit_renderer_ref->vulkan.core.context.renderdata.descriptors.layout);
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushRange;
 
     VkResult result = vkCreatePipelineLayout(
         g_vinit_renderer_ref->vulkan.core.general.interface,
@@ -289,24 +471,258 @@ BOOL VINIT_Pipeline(VulkanPipeline* pipeline) {
         return FALSE;
     }
 
-    VkComputePipelineCreateInfo pipelineInfo = { 0 };
-    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
-    pipelineInfo.layout = pipeline->layout;
-    pipelineInfo.stage = compShaderStageInfo;
+    // tracing variants are built on first use
+    for (uint32_t i = 0; i < PIPELINE_VARIANTS; i++)
+        pipeline->variants[i] = VK_NULL_HANDLE;
 
-    result = vkCreateComputePipelines(
-        g_vinit_renderer_ref->vulkan.core.general.interface,
-        VK_NULL_HANDLE, 1, &pipelineInfo, NULL, &(pipeline->pipeline));
-    if (result != VK_SUCCESS) {
-        LOG_FATAL("Failed to create pipeline!");
-        return FALSE;
+    PipelineSpecialization data = { 0 };
+    VkSpecializationMapEntry entries[2 + PIPELINE_FEATURES] = { 0 };
+    VkSpecializationInfo info = { 0 };
+    VINIT_Specialization(0, &data, entries, &info);
+    return VINIT_ComputePipeline("build/shaders/resolve.comp.spv", pipeline->layout, &info, &(pipeline->resolve));
+}
+
+VkPipeline VINIT_PipelineVariant(VulkanPipeline* pipeline, uint32_t variant) {
+    if (pipeline->variants[variant] != VK_NULL_HANDLE) return pipeline->variants[variant];
+    PipelineSpecialization data = { 0 };
+    VkSpecializationMapEntry entries[2 + PIPELINE_FEATURES] = { 0 };
+    VkSpecializationInfo info = { 0 };
+    VINIT_Specialization(variant, &data, entries, &info);
+    if (!VINIT_ComputePipeline("build/shaders/shader.comp.spv", pipeline->layout, &info, &(pipeline->variants[variant]))) {
+        pipeline->variants[variant] = VK_NULL_HANDLE;
+        return VK_NULL_HANDLE;
     }
+    return pipeline->variants[variant];
+}
 
-    FreeFile(compshadercode);
-	vkDestroyShaderModule(g_vinit_renderer_ref->vulkan.core.general.interface, compshader, NULL);
+BOOL VINIT_Wavefront(VulkanWavefront* wavefront) {
+    VkDeviceSize pixels = (VkDeviceSize)g_vinit_renderer_ref->dimensions.x * (VkDeviceSize)g_vinit_renderer_ref->dimensions.y;
+
+    // create queues and per ray scratch, the secondary queue follows the primary one
+    VUTIL_CreateBuffer(
+        sizeof(WavefrontCounters),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        MEMORY_BUDDY,
+        &(wavefront->counters));
+    VUTIL_CreateBuffer(
+        sizeof(WavefrontRay) * pixels * WAVEFRONT_QUEUES,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        MEMORY_BUDDY,
+        &(wavefront->queues));
+    VUTIL_CreateBuffer(
+        sizeof(WavefrontHit) * pixels,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        MEMORY_BUDDY,
+        &(wavefront->hits));
+    VUTIL_CreateBuffer(
+        sizeof(uint32_t) * pixels,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        MEMORY_BUDDY,
+        &(wavefront->visibility));
+    VUTIL_CreateBuffer(
+        sizeof(vec4) * pixels,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        MEMORY_BUDDY,
+        &(wavefront->pixels));
+
+    for (uint32_t i = 0; i < PIPELINE_VARIANTS; i++)
+        wavefront->variants[i].generate = VK_NULL_HANDLE;
+
+    wavefront->ready = TRUE;
+    VUPDT_DescriptorSets(&(g_vinit_renderer_ref->vulkan.core.context.renderdata.descriptors));
+    return TRUE;
+}
+
+WavefrontKernels* VINIT_WavefrontVariant(VulkanWavefront* wavefront, uint32_t variant) {
+    WavefrontKernels* kernels = &(wavefront->variants[variant]);
+    if (kernels->generate != VK_NULL_HANDLE) return kernels;
+    PipelineSpecialization data = { 0 };
+    VkSpecializationMapEntry entries[2 + PIPELINE_FEATURES] = { 0 };
+    VkSpecializationInfo info = { 0 };
+    VINIT_Specialization(variant, &data, entries, &info);
+    VkPipelineLayout layout = g_vinit_renderer_ref->vulkan.core.context.pipeline.layout;
+    *kernels = (WavefrontKernels){ 0 };
+
+    // generate doubles as the built flag so it goes last
+    BOOL built =
+        VINIT_ComputePipeline("build/shaders/wf_args.comp.spv", layout, &info, &(kernels->args)) &&
+        VINIT_ComputePipeline("build/shaders/wf_extend.comp.spv", layout, &info, &(kernels->extend)) &&
+        VINIT_ComputePipeline("build/shaders/wf_connect.comp.spv", layout, &info, &(kernels->connect)) &&
+        VINIT_ComputePipeline("build/shaders/wf_shade.comp.spv", layout, &info, &(kernels->shade)) &&
+        VINIT_ComputePipeline("build/shaders/wf_resolve.comp.spv", layout, &info, &(kernels->resolve)) &&
+        VINIT_ComputePipeline("build/shaders/wf_generate.comp.spv", layout, &info, &(kernels->generate));
+    if (built) return kernels;
+
+    // drop the stages that did compile so a half built variant is never bound
+    VkDevice device = g_vinit_renderer_ref->vulkan.core.general.interface;
+    vkDestroyPipeline(device, kernels->args, NULL);
+    vkDestroyPipeline(device, kernels->extend, NULL);
+    vkDestroyPipeline(device, kernels->connect, NULL);
+    vkDestroyPipeline(device, kernels->shade, NULL);
+    vkDestroyPipeline(device, kernels->resolve, NULL);
+    *kernels = (WavefrontKernels){ 0 };
+    return NULL;
+}
+
+BOOL VINIT_Timestamps(VulkanTimestamps* timestamps) {
+    // timestamps are optional, the graphics family has to support them
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(g_vinit_renderer_ref->vulkan.core.general.gpu, &properties);
+    VulkanFamilyGroup families = VUTIL_FindQueueFamilies(g_vinit_renderer_ref->vulkan.core.general.gpu);
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(g_vinit_renderer_ref->vulkan.core.general.gpu, &queueFamilyCount, NULL);
+    VkQueueFamilyProperties* queueFamilies = EZALLOC(queueFamilyCount, sizeof(VkQueueFamilyProperties));
+    vkGetPhysicalDeviceQueueFamilyProperties(g_vinit_renderer_ref->vulkan.core.general.gpu, &queueFamilyCount, queueFamilies);
+    uint32_t bits = queueFamilies[families.graphics.value].timestampValidBits;
+    EZFREE(queueFamilies);
+    timestamps->ready = FALSE;
+    if (bits == 0 || properties.limits.timestampPeriod == 0.0f) {
+        LOG_WARN("GPU timestamps are not supported, gpu stage profiling disabled");
+        return TRUE;
+    }
+    timestamps->mask = bits >= 64 ? UINT64_MAX : ((1ULL << bits) - 1);
+    timestamps->period = properties.limits.timestampPeriod;
+
+    // one pool per swap so a frame in flight is never overwritten
+    for (size_t i = 0; i < CPUSWAP_MAX; i++) {
+        VkQueryPoolCreateInfo poolInfo = { 0 };
+        poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        poolInfo.queryCount = TIMESTAMP_QUERIES;
+        VkResult result = vkCreateQueryPool(
+            g_vinit_renderer_ref->vulkan.core.general.interface,
+            &poolInfo, NULL, &(timestamps->pools[i]));
+        if (result != VK_SUCCESS) {
+            LOG_FATAL("Failed to create timestamp query pool");
+            return FALSE;
+        }
+        timestamps->uploads[i] = 0;
+        timestamps->pending[i] = FALSE;
+    }
+    timestamps->ready = TRUE;
+    return TRUE;
+}
+
+BOOL VINIT_Selection(VulkanSelection* selection) {
+    // one slot per pixel behind the indirect args, shared between swaps like the wavefront queues
+    VkDeviceSize pixels = (VkDeviceSize)g_vinit_renderer_ref->dimensions.x * (VkDeviceSize)g_vinit_renderer_ref->dimensions.y;
+    VUTIL_CreateBuffer(
+        sizeof(SelectionHeader) + sizeof(uint32_t) * pixels,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        MEMORY_BUDDY,
+        &(selection->list));
+
+    // kernels are built on first use
+    selection->select = VK_NULL_HANDLE;
+    for (uint32_t i = 0; i < PIPELINE_VARIANTS; i++)
+        selection->compact[i] = VK_NULL_HANDLE;
+    return TRUE;
+}
+
+VkPipeline VINIT_SelectionVariant(VulkanSelection* selection, uint32_t variant) {
+    if (selection->compact[variant] != VK_NULL_HANDLE) return selection->compact[variant];
+    PipelineSpecialization data = { 0 };
+    VkSpecializationMapEntry entries[2 + PIPELINE_FEATURES] = { 0 };
+    VkSpecializationInfo info = { 0 };
+    if (selection->select == VK_NULL_HANDLE) {
+        VINIT_Specialization(0, &data, entries, &info);
+        if (!VINIT_ComputePipeline("build/shaders/select.comp.spv", g_vinit_renderer_ref->vulkan.core.context.pipeline.layout, &info, &(selection->select))) {
+            selection->select = VK_NULL_HANDLE;
+            return VK_NULL_HANDLE;
+        }
+    }
+    VINIT_Specialization(variant, &data, entries, &info);
+    if (!VINIT_ComputePipeline("build/shaders/compact.comp.spv", g_vinit_renderer_ref->vulkan.core.context.pipeline.layout, &info, &(selection->compact[variant]))) {
+        selection->compact[variant] = VK_NULL_HANDLE;
+        return VK_NULL_HANDLE;
+    }
+    return selection->compact[variant];
+}
+
+BOOL VINIT_Reprojection(VulkanReprojection* reprojection) {
+    if (!VINIT_PixelImages(&(reprojection->history), 1, HISTORY_FORMAT)) return FALSE;
+    if (!VINIT_PixelImages(&(reprojection->scratch), 1, HISTORY_FORMAT)) return FALSE;
+    if (!VINIT_PixelImages(&(reprojection->keys), 1, DEPTHKEY_FORMAT)) return FALSE;
+
+    // kernels are built on first use, history is cleared the first frame it is used
+    reprojection->reproject = VK_NULL_HANDLE;
+    reprojection->present = VK_NULL_HANDLE;
+    reprojection->moved = FALSE;
+    reprojection->active = FALSE;
     return TRUE;
 }
 
+BOOL VINIT_ReprojectionKernels(VulkanReprojection* reprojection) {
+    if (reprojection->reproject != VK_NULL_HANDLE) return TRUE;
+    PipelineSpecialization data = { 0 };
+    VkSpecializationMapEntry entries[2 + PIPELINE_FEATURES] = { 0 };
+    VkSpecializationInfo info = { 0 };
+    VINIT_Specialization(0, &data, entries, &info);
+    VkPipelineLayout layout = g_vinit_renderer_ref->vulkan.core.context.pipeline.layout;
+
+    // reproject doubles as the built flag so it goes last
+    reprojection->present = VK_NULL_HANDLE;
+    BOOL built =
+        VINIT_ComputePipeline("build/shaders/history.comp.spv", layout, &info, &(reprojection->present)) &&
+        VINIT_ComputePipeline("build/shaders/reproject.comp.spv", layout, &info, &(reprojection->reproject));
+    if (built) return TRUE;
+
+    // drop the half that did compile so the pair is never used apart
+    vkDestroyPipeline(g_vinit_renderer_ref->vulkan.core.general.interface, reprojection->present, NULL);
+    reprojection->present = VK_NULL_HANDLE;
+    reprojection->reproject = VK_NULL_HANDLE;
+    return FALSE;
+}
+
+BOOL VINIT_Denoiser(VulkanDenoiser* denoiser) {
+    if (!VINIT_PixelImages(denoiser->images, DENOISE_BINDINGS, DENOISE_FORMAT)) return FALSE;
+    denoiser->filter = VK_NULL_HANDLE;
+    return TRUE;
+}
+
+VkPipeline VINIT_DenoiserKernel(VulkanDenoiser* denoiser) {
+    if (denoiser->filter != VK_NULL_HANDLE) return denoiser->filter;
+    PipelineSpecialization data = { 0 };
+    VkSpecializationMapEntry entries[2 + PIPELINE_FEATURES] = { 0 };
+    VkSpecializationInfo info = { 0 };
+    VINIT_Specialization(0, &data, entries, &info);
+    if (!VINIT_ComputePipeline("build/shaders/denoise.comp.spv", g_vinit_renderer_ref->vulkan.core.context.pipeline.layout, &info, &(denoiser->filter))) {
+        denoiser->filter = VK_NULL_HANDLE;
+        return VK_NULL_HANDLE;
+    }
+    return denoiser->filter;
+}
+
+BOOL VINIT_Interleave(VulkanInterleave* interleave) {
+    if (!VINIT_PixelImages(&(interleave->lattice), 1, INTERLEAVE_FORMAT)) return FALSE;
+
+    // the kernel is built on first use, the lattice is cleared the first frame it is used
+    interleave->reconstruct = VK_NULL_HANDLE;
+    interleave->frame = 0;
+    interleave->settled = 0;
+    interleave->active = FALSE;
+    return TRUE;
+}
+
+VkPipeline VINIT_InterleaveKernel(VulkanInterleave* interleave) {
+    if (interleave->reconstruct != VK_NULL_HANDLE) return interleave->reconstruct;
+    PipelineSpecialization data = { 0 };
+    VkSpecializationMapEntry entries[2 + PIPELINE_FEATURES] = { 0 };
+    VkSpecializationInfo info = { 0 };
+    VINIT_Specialization(0, &data, entries, &info);
+    if (!VINIT_ComputePipeline("build/shaders/reconstruct.comp.spv", g_vinit_renderer_ref->vulkan.core.context.pipeline.layout, &info, &(interleave->reconstruct))) {
+        interleave->reconstruct = VK_NULL_HANDLE;
+        return VK_NULL_HANDLE;
+    }
+    return interleave->reconstruct;
+}
+
 BOOL VINIT_Scheduler(VulkanScheduler* scheduler) {
 	// create syncro
 	if (!VINIT_Syncro(&(scheduler->syncro))) return FALSE;
@@ -314,25 +730,74 @@ BOOL VINIT_Scheduler(VulkanScheduler* scheduler) {
 	// create commands
 	if (!VINIT_Commands(&(scheduler->commands))) return FALSE;	
 
+	// create timestamp queries
+	if (!VINIT_Timestamps(&(scheduler->timestamps))) return FALSE;
+
 	// create queue
-	return VINIT_Queue(&(scheduler->queue));
+	if (!VINIT_Queue(&(scheduler->queue))) return FALSE;
+
+	// create upload queue
+	return VINIT_Transfer(&(scheduler->transfer));
 }
 
-BOOL VINIT_Bridge(VulkanDataBuffer* bridge) {
-    // create cross buffer
-    VUTIL_CreateBuffer(
-        g_vinit_renderer_ref->dimensions.x * g_vinit_renderer_ref->dimensions.y * 4, // Assuming VK_FORMAT_B8G8R8A8_SRGB
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
-        bridge);
+BOOL VINIT_Bridges(VulkanDataBuffer* bridges, size_t from, size_t to) {
+    // create cross buffers, one per slot so a copy in flight never lands in the one being streamed
+    for (size_t i = from; i < to; i++) {
+        VUTIL_CreateBuffer(
+            g_vinit_renderer_ref->dimensions.x * g_vinit_renderer_ref->dimensions.y * 4, // Assuming VK_FORMAT_B8G8R8A8_SRGB
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+            MEMORY_BUDDY,
+            &(bridges[i]));
+    }
+    return TRUE;
+}
 
-    // map memory to buffer
-    vkMapMemory(g_vinit_renderer_ref->vulkan.core.general.interface, bridge->memory, 0, VK_WHOLE_SIZE, 0, &(g_vinit_renderer_ref->swapchain.reference));
+BOOL VINIT_Accumulation(VulkanAccumulation* accumulation, size_t from, size_t to) {
+    for (size_t i = from; i < to; i++) {
+        VUTIL_CreateImage(
+            g_vinit_renderer_ref->dimensions.x,
+            g_vinit_renderer_ref->dimensions.y,
+            1,
+            VK_SAMPLE_COUNT_1_BIT,
+            ACCUMULATION_FORMAT,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            &(accumulation->images[i]));
+        VUTIL_TransitionImageLayout(
+            accumulation->images[i].image,
+            ACCUMULATION_FORMAT,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_GENERAL,
+            1);
+        accumulation->samples[i] = 0;
+        accumulation->reset[i] = TRUE;
+    }
+    return TRUE;
+}
+
+BOOL VINIT_SwapSlots(VulkanRenderContext* context, size_t count) {
+    // per swap images only exist for slots the ring has used, growing leaves the old ones alone
+    size_t from = context->slots;
+    if (count <= from) return TRUE;
+	if (!VINIT_Targets(context->targets, from, count)) return FALSE;
+	if (!VINIT_Bridges(context->bridges, from, count)) return FALSE;
+	if (!VINIT_Accumulation(&(context->accumulation), from, count)) return FALSE;
+	if (!VINIT_PixelImages(context->renderdata.ages + from, count - from, AGE_FORMAT)) return FALSE;
+	if (!VINIT_PixelImages(context->renderdata.variances + from, count - from, VARIANCE_FORMAT)) return FALSE;
+    for (size_t i = from; i < count; i++) context->renderdata.retrace[i] = TRUE;
+    context->slots = count;
     return TRUE;
 }
 
 BOOL VINIT_RenderContext(VulkanRenderContext* context) {
-	if (!VINIT_Targets(context->targets)) return FALSE;
+	if (!VINIT_SwapSlots(context, g_vinit_renderer_ref->swapchain.length)) return FALSE;
+	if (!VINIT_Selection(&(context->selection))) return FALSE;
+	if (!VINIT_Reprojection(&(context->reprojection))) return FALSE;
+	if (!VINIT_Denoiser(&(context->denoiser))) return FALSE;
+	if (!VINIT_Interleave(&(context->interleave))) return FALSE;
 	if (!VINIT_RenderData(&(context->renderdata))) return FALSE;
 	if (!VINIT_Pipeline(&(context->pipeline))) return FALSE;
     return TRUE;
@@ -345,6 +810,7 @@ BOOL VINIT_Triangles(VulkanDataBuffer* triangles) {
         arrsize,
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        MEMORY_BUDDY,
         triangles);
     VUPDT_Triangles(triangles);
     return TRUE;
@@ -357,6 +823,7 @@ BOOL VINIT_SDFs(VulkanDataBuffer* sdfs) {
         arrsize,
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        MEMORY_BUDDY,
         sdfs);
     VUPDT_SDFs(sdfs);
     return TRUE;
@@ -369,6 +836,7 @@ BOOL VINIT_Materials(VulkanDataBuffer* materials) {
         arrsize,
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        MEMORY_BUDDY,
         materials);
     VUPDT_Materials(materials);
     return TRUE;
@@ -381,13 +849,14 @@ BOOL VINIT_BoundingVolumeHierarchy(VulkanDataBuffer* bvh) {
         arrsize,
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        MEMORY_BUDDY,
         bvh);
     VUPDT_BoundingVolumeHierarchy(bvh);
     return TRUE;
 }
 
-BOOL VINIT_Targets(VulkanImage* targets_arr) {
-    for (size_t i = 0; i < CPUSWAP_LENGTH; i++) {
+BOOL VINIT_Targets(VulkanImage* targets_arr, size_t from, size_t to) {
+    for (size_t i = from; i < to; i++) {
         VUTIL_CreateImage(
             g_vinit_renderer_ref->dimensions.x,
             g_vinit_renderer_ref->dimensions.y,
@@ -509,19 +978,25 @@ BOOL VINIT_General(VulkanGeneral* general) {
 
 	// create device interface
 	VulkanFamilyGroup families = VUTIL_FindQueueFamilies(general->gpu);
-    VkDeviceQueueCreateInfo queueCreateInfo = { 0 };
-    queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queueCreateInfo.queueFamilyIndex = families.graphics.value;
-    queueCreateInfo.queueCount = 1;
     float queuePriority = 1.0f;
-    queueCreateInfo.pQueuePriorities = &queuePriority;
+    VkDeviceQueueCreateInfo queueCreateInfos[2] = { 0 };
+    queueCreateInfos[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueCreateInfos[0].queueFamilyIndex = families.graphics.value;
+    queueCreateInfos[0].queueCount = 1;
+    queueCreateInfos[0].pQueuePriorities = &queuePriority;
+
+    // a second family for uploads when the gpu has one
+    queueCreateInfos[1].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueCreateInfos[1].queueFamilyIndex = families.transfer.value;
+    queueCreateInfos[1].queueCount = 1;
+    queueCreateInfos[1].pQueuePriorities = &queuePriority;
     VkPhysicalDeviceFeatures deviceFeatures = { 0 };
     deviceFeatures.samplerAnisotropy = VK_TRUE;
     deviceFeatures.sampleRateShading = VK_TRUE;
     VkDeviceCreateInfo deviceCreateInfo = { 0 };
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
-    deviceCreateInfo.queueCreateInfoCount = 1;
+    deviceCreateInfo.pQueueCreateInfos = queueCreateInfos;
+    deviceCreateInfo.queueCreateInfoCount = families.transfer.exists ? 2 : 1;
     deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
     deviceCreateInfo.enabledExtensionCount = g_vinit_renderer_ref->vulkan.metadata.extensions.device.size;
     deviceCreateInfo.ppEnabledExtensionNames  = g_vinit_renderer_ref->vulkan.metadata.extensions.device.data;
@@ -569,11 +1044,23 @@ BOOL VINIT_Metadata(VulkanMetadata* metadata) {
     return TRUE;
 }
 
+BOOL VINIT_Memory(VulkanMemory* memory) {
+    vkGetPhysicalDeviceMemoryProperties(g_vinit_renderer_ref->vulkan.core.general.gpu, &(memory->properties));
+
+    // leaves never share a granularity page, so buffers and optimal images can sit in one block
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(g_vinit_renderer_ref->vulkan.core.general.gpu, &properties);
+    memory->leaf = MEMORY_BUDDY_LEAF;
+    while (memory->leaf < properties.limits.bufferImageGranularity) memory->leaf <<= 1;
+    memory->report = (MemoryReport){ 0 };
+    return TRUE;
+}
+
 BOOL VINIT_Core(VulkanCore* core) {
 	if (!VINIT_General(&(core->general))) return FALSE;
+	if (!VINIT_Memory(&(core->memory))) return FALSE;
 	if (!VINIT_Geometry(&(core->geometry))) return FALSE;
 	if (!VINIT_Scheduler(&(core->scheduler))) return FALSE;
-	if (!VINIT_Bridge(&(core->bridge))) return FALSE;
 	if (!VINIT_RenderContext(&(core->context))) return FALSE;
     return TRUE;
 }
@@ -1,53 +1,85 @@
-#ifndef VINIT_H
-#define VINIT_H
-
-#include "data/config.h"
-#include "renderer/vulkan/vstructs.h"
-
-BOOL VINIT_Lights(VulkanDataBuffer* lights);
-
-BOOL VINIT_Queue(VkQueue* queue);
-
-BOOL VINIT_Commands(VulkanCommands* commands);
-
-BOOL VINIT_Syncro(VulkanSyncro* syncro);
-
-BOOL VINIT_UniformBuffers(UBOArray* ubos);
-
-BOOL VINIT_Descriptors(VulkanDescriptors* descriptors);
-
-BOOL VINIT_ShaderStorageBuffers(VulkanDataBuffer* ssbo_array);
-
-BOOL VINIT_RenderData(VulkanRenderData* renderdata);
-
-BOOL VINIT_Pipeline(VulkanPipeline* pipeline);
-
-BOOL VINIT_Scheduler(VulkanScheduler* scheduler);
-
-BOOL VINIT_Bridge(VulkanDataBuffer* bridge);
-
-BOOL VINIT_RenderContext(VulkanRenderContext* context);
-
-BOOL VINIT_Triangles(VulkanDataBuffer* triangles);
-
-BOOL VINIT_SDFs(VulkanDataBuffer* sdfs);
-
-BOOL VINIT_Materials(VulkanDataBuffer* materials);
-
-BOOL VINIT_BoundingVolumeHierarchy(VulkanDataBuffer* bvh);
-
-BOOL VINIT_Targets(VulkanImage* targets_arr);
-
-BOOL VINIT_General(VulkanGeneral* general);
-
-BOOL VINIT_Geometry(VulkanGeometry* geometry);
-
-BOOL VINIT_Metadata(VulkanMetadata* metadata);
-
-BOOL VINIT_Core(VulkanCore* core);
-
-BOOL VINIT_Vulkan(VulkanObject* vulkan);
-
-void VINIT_SetVulkanInitContext(Renderer* renderer);
-
-#endif
+#ifndef VINIT_H
+#define VINIT_H
+
+#include "data/config.h"
+#include "renderer/vulkan/vstructs.h"
+
+BOOL VINIT_Lights(VulkanDataBuffer* lights);
+
+BOOL VINIT_Queue(VkQueue* queue);
+
+BOOL VINIT_Transfer(VulkanTransfer* transfer);
+
+BOOL VINIT_Commands(VulkanCommands* commands);
+
+BOOL VINIT_Syncro(VulkanSyncro* syncro);
+
+BOOL VINIT_UniformBuffers(UBOArray* ubos);
+
+BOOL VINIT_Descriptors(VulkanDescriptors* descriptors);
+
+BOOL VINIT_PixelImages(VulkanImage* images, size_t count, VkFormat format);
+
+BOOL VINIT_RenderData(VulkanRenderData* renderdata);
+
+void VINIT_Specialization(uint32_t variant, PipelineSpecialization* data, VkSpecializationMapEntry* entries, VkSpecializationInfo* info);
+
+BOOL VINIT_ComputePipeline(const char* path, VkPipelineLayout layout, VkSpecializationInfo* specialization, VkPipeline* pipeline);
+
+BOOL VINIT_PipelineCache(VkPipelineCache* cache);
+
+BOOL VINIT_Pipeline(VulkanPipeline* pipeline);
+
+VkPipeline VINIT_PipelineVariant(VulkanPipeline* pipeline, uint32_t variant);
+
+BOOL VINIT_Wavefront(VulkanWavefront* wavefront);
+
+WavefrontKernels* VINIT_WavefrontVariant(VulkanWavefront* wavefront, uint32_t variant);
+
+BOOL VINIT_Timestamps(VulkanTimestamps* timestamps);
+
+BOOL VINIT_Selection(VulkanSelection* selection);
+
+VkPipeline VINIT_SelectionVariant(VulkanSelection* selection, uint32_t variant);
+BOOL VINIT_Reprojection(VulkanReprojection* reprojection);
+BOOL VINIT_ReprojectionKernels(VulkanReprojection* reprojection);
+BOOL VINIT_Denoiser(VulkanDenoiser* denoiser);
+VkPipeline VINIT_DenoiserKernel(VulkanDenoiser* denoiser);
+BOOL VINIT_Interleave(VulkanInterleave* interleave);
+VkPipeline VINIT_InterleaveKernel(VulkanInterleave* interleave);
+
+BOOL VINIT_Scheduler(VulkanScheduler* scheduler);
+
+BOOL VINIT_Bridges(VulkanDataBuffer* bridges, size_t from, size_t to);
+
+BOOL VINIT_Accumulation(VulkanAccumulation* accumulation, size_t from, size_t to);
+
+BOOL VINIT_SwapSlots(VulkanRenderContext* context, size_t count);
+
+BOOL VINIT_RenderContext(VulkanRenderContext* context);
+
+BOOL VINIT_Triangles(VulkanDataBuffer* triangles);
+
+BOOL VINIT_SDFs(VulkanDataBuffer* sdfs);
+
+BOOL VINIT_Materials(VulkanDataBuffer* materials);
+
+BOOL VINIT_BoundingVolumeHierarchy(VulkanDataBuffer* bvh);
+
+BOOL VINIT_Targets(VulkanImage* targets_arr, size_t from, size_t to);
+
+BOOL VINIT_General(VulkanGeneral* general);
+
+BOOL VINIT_Geometry(VulkanGeometry* geometry);
+
+BOOL VINIT_Metadata(VulkanMetadata* metadata);
+
+BOOL VINIT_Memory(VulkanMemory* memory);
+
+BOOL VINIT_Core(VulkanCore* core);
+
+BOOL VINIT_Vulkan(VulkanObject* vulkan);
+
+void VINIT_SetVulkanInitContext(Renderer* renderer);
+
+#endif
@@ -1,3 +1,6 @@
-#include "vstructs.h"
-
-IMPL_ARRLIST(StaticString);
\ No newline at end of file
+#include "vstructs.h"
+
+IMPL_ARRLIST(StaticString);
+IMPL_ARRLIST(VulkanDataBuffer);
+IMPL_ARRLIST(VkBuffer);
+IMPL_ARRLIST(VulkanMemoryBlock);
\ No newline at end of file
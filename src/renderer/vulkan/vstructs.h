@@ -1,148 +1,354 @@
-#ifndef VSTRUCTS_H
-#define VSTRUCTS_H
-
-#include "renderer/rstructs.h"
-#include <vulkan/vulkan.h>
-
-typedef struct {
-    VkImage image;
-    VkImageView view;
-    VkDeviceMemory memory;
-} VulkanImage;
-
-typedef struct {
-    Schrodingnum graphics;
-} VulkanFamilyGroup;
-
-typedef struct {
-    VkFence fences[CPUSWAP_LENGTH];
-} VulkanSyncro;
-
-typedef struct {
-    alignas(16) vec3 look;
-    alignas(16) vec3 position;
-    alignas(16) vec3 up;
-    alignas(16) vec3 u;
-    alignas(16) vec3 v;
-    alignas(16) vec3 w;
-    alignas(4) float fov;
-    alignas(4) float width;
-    alignas(4) float height;
-    alignas(4) uint32_t triangles;
-    alignas(8) vec2 viewport;
-    alignas(4) uint32_t bvhsize;
-	alignas(4) float frametime;
-	alignas(4) float frameless;
-	alignas(4) uint32_t seed;
-	alignas(4) uint32_t shadows;
-	alignas(4) uint32_t reflections;
-	alignas(4) uint32_t lighting;
-	alignas(4) uint32_t raytrace;
-	alignas(4) uint32_t sdf;
-    alignas(4) uint32_t sdfsize;
-    alignas(4) float sdfsmooth;
-    alignas(4) uint32_t maxmarches;
-    alignas(4) float time;
-    alignas(4) uint32_t antialiasing;
-    alignas(4) uint32_t lightssize;
-} UniformBufferObject;
-
-typedef struct {
-    VkBuffer buffer;
-    VkDeviceMemory memory;
-} VulkanDataBuffer;
-
-typedef struct {
-    VulkanDataBuffer objects[CPUSWAP_LENGTH];
-    void* mapped[CPUSWAP_LENGTH];
-} UBOArray;
-
-typedef struct {
-    VkDebugUtilsMessengerEXT messenger;
-    VkInstance instance;
-    VkPhysicalDevice gpu;
-    VkDevice interface;
-} VulkanGeneral;
-
-typedef struct {
-    VkPipeline pipeline;
-    VkPipelineLayout layout;
-} VulkanPipeline;
-
-typedef struct {
-    VkCommandPool pool;
-    VkCommandBuffer commands[CPUSWAP_LENGTH];
-} VulkanCommands;
-
-typedef struct {
-    VkDescriptorPool pool;
-    VkDescriptorSet sets[CPUSWAP_LENGTH];
-    VkDescriptorSetLayout layout;
-} VulkanDescriptors;
-
-typedef struct {
-    VulkanSyncro syncro;
-    VulkanCommands commands;
-    VkQueue queue;
-} VulkanScheduler;
-
-typedef struct {
-    VulkanDescriptors descriptors;
-    UBOArray ubos;
-    VulkanDataBuffer ssbos[CPUSWAP_LENGTH];
-} VulkanRenderData;
-
-typedef struct {
-    VulkanPipeline pipeline;
-    VulkanRenderData renderdata;
-    VulkanImage targets[CPUSWAP_LENGTH];
-} VulkanRenderContext;
-
-typedef struct {
-    VulkanDataBuffer triangles;
-    VulkanDataBuffer materials;
-    VulkanDataBuffer bvh;
-    VulkanDataBuffer sdfs;
-    VulkanDataBuffer lights;
-} VulkanGeometry;
-
-typedef struct {
-    VulkanImage image;
-} VulkanTarget;
-
-typedef struct {
-    VulkanGeneral general;
-    VulkanGeometry geometry;
-    VulkanRenderContext context;
-    VulkanDataBuffer bridge;
-    VulkanScheduler scheduler;
-    VulkanTarget target;
-} VulkanCore;
-
-typedef struct {
-    ARRLIST_StaticString required;
-    ARRLIST_StaticString device;
-} VulkanExtensionData;
-
-typedef struct {
-    VulkanExtensionData extensions;
-    ARRLIST_StaticString validation;
-} VulkanMetadata;
-
-typedef struct {
-    VulkanCore core;
-    VulkanMetadata metadata;
-} VulkanObject;
-
-typedef struct {
-    RendererStats stats;
-    VulkanObject vulkan;
-    CPUSwap swapchain;
-    Vector2 dimensions;
-    Geometry geometry;
-    SimpleCamera camera;
-    Vector2 viewport;
-    RendererConfig config;
-} Renderer;
-
-#endif
+#ifndef VSTRUCTS_H
+#define VSTRUCTS_H
+
+#include "renderer/rstructs.h"
+#include "renderer/cpu/cstructs.h"
+#include <vulkan/vulkan.h>
+
+typedef enum {
+    MEMORY_BUDDY = 0,
+    MEMORY_LINEAR = 1,
+    MEMORY_STRATEGIES = 2,
+} MemoryStrategy;
+
+typedef struct {
+    VkDeviceMemory memory;
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    void* mapped;
+    uint32_t type;
+    uint32_t block;
+    uint32_t order;
+    MemoryStrategy strategy;
+} VulkanAllocation;
+
+typedef struct {
+    VkDeviceMemory memory;
+    VkDeviceSize size;
+    VkDeviceSize used;
+    VkDeviceSize head;
+    VkDeviceSize leaf;
+    uint32_t orders;
+    uint32_t allocations;
+    uint8_t* tree;
+    void* mapped;
+    BOOL dedicated;
+} VulkanMemoryBlock;
+
+DECLARE_ARRLIST(VulkanMemoryBlock);
+
+typedef struct {
+    ARRLIST_VulkanMemoryBlock blocks[MEMORY_STRATEGIES];
+} VulkanMemoryPool;
+
+typedef struct {
+    VulkanMemoryPool pools[VK_MAX_MEMORY_TYPES];
+    VkPhysicalDeviceMemoryProperties properties;
+    VkDeviceSize leaf;
+    MemoryReport report;
+} VulkanMemory;
+
+typedef struct {
+    VkImage image;
+    VkImageView view;
+    VulkanAllocation allocation;
+} VulkanImage;
+
+typedef struct {
+    Schrodingnum graphics;
+    Schrodingnum transfer;
+} VulkanFamilyGroup;
+
+typedef struct {
+    VkFence fences[CPUSWAP_MAX];
+} VulkanSyncro;
+
+typedef struct {
+    alignas(4) float width;
+    alignas(4) float height;
+    alignas(4) uint32_t triangles;
+    alignas(8) vec2 viewport;
+    alignas(4) uint32_t bvhsize;
+	alignas(4) float frameless;
+    alignas(4) uint32_t sdfsize;
+    alignas(4) float sdfsmooth;
+    alignas(4) uint32_t maxmarches;
+    alignas(4) uint32_t lightssize;
+    alignas(4) uint32_t accumulate;
+    alignas(4) uint32_t variance;
+    alignas(4) uint32_t reproject;
+    alignas(16) vec4 previous[4];
+    alignas(4) uint32_t denoise;
+    alignas(4) uint32_t interleave;
+    alignas(4) uint32_t phase;
+    alignas(4) uint32_t settled;
+    alignas(4) uint32_t slot;
+} UniformBufferObject;
+
+typedef struct {
+    alignas(16) vec3 position;
+    alignas(4) float fov;
+    alignas(16) vec3 u;
+    alignas(4) float frametime;
+    alignas(16) vec3 v;
+    alignas(4) float time;
+    alignas(16) vec3 w;
+    alignas(4) uint32_t sequence;
+    alignas(4) uint32_t samples;
+    alignas(4) uint32_t queue;
+    alignas(4) uint32_t sample;
+    alignas(8) uint32_t origin[2];
+} FramePushConstants;
+
+typedef struct {
+    VkBuffer buffer;
+    VulkanAllocation allocation;
+} VulkanDataBuffer;
+DECLARE_ARRLIST(VulkanDataBuffer);
+DECLARE_ARRLIST(VkBuffer);
+
+typedef struct {
+    VulkanDataBuffer objects[CPUSWAP_MAX];
+    void* mapped[CPUSWAP_MAX];
+    UniformBufferObject contents[CPUSWAP_MAX];
+} UBOArray;
+
+typedef struct {
+    VkDebugUtilsMessengerEXT messenger;
+    VkInstance instance;
+    VkPhysicalDevice gpu;
+    VkDevice interface;
+} VulkanGeneral;
+
+typedef struct {
+    alignas(4) uint32_t width;
+    alignas(4) uint32_t height;
+    alignas(4) VkBool32 features[PIPELINE_FEATURES];
+} PipelineSpecialization;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendor;
+    uint32_t device;
+    uint32_t driver;
+    uint32_t reserved;
+    uint8_t uuid[VK_UUID_SIZE];
+    uint64_t shaders;
+    uint64_t size;
+    uint64_t checksum;
+} PipelineCacheHeader;
+
+typedef struct {
+    VkPipelineCache cache;
+    VkPipeline variants[PIPELINE_VARIANTS];
+    VkPipeline resolve;
+    VkPipelineLayout layout;
+    VkExtent2D tile;
+} VulkanPipeline;
+
+typedef struct {
+    VulkanImage images[CPUSWAP_MAX];
+    uint32_t samples[CPUSWAP_MAX];
+    BOOL reset[CPUSWAP_MAX];
+    SimpleCamera camera;
+    RendererConfig config;
+    Vector2 viewport;
+} VulkanAccumulation;
+
+typedef struct {
+    alignas(16) vec4 origin;
+    alignas(16) vec4 direction;
+    alignas(16) vec4 view;
+    alignas(16) vec4 local;
+} WavefrontRay;
+
+typedef struct {
+    alignas(16) vec4 position;
+    alignas(16) vec4 normal;
+} WavefrontHit;
+
+typedef struct {
+    alignas(4) uint32_t counts[WAVEFRONT_QUEUES];
+    alignas(16) uint32_t args[WAVEFRONT_QUEUES][4];
+} WavefrontCounters;
+
+typedef struct {
+    VkPipeline generate;
+    VkPipeline args;
+    VkPipeline extend;
+    VkPipeline connect;
+    VkPipeline shade;
+    VkPipeline resolve;
+} WavefrontKernels;
+
+typedef struct {
+    WavefrontKernels variants[PIPELINE_VARIANTS];
+    VulkanDataBuffer counters;
+    VulkanDataBuffer queues;
+    VulkanDataBuffer hits;
+    VulkanDataBuffer visibility;
+    VulkanDataBuffer pixels;
+    BOOL ready;
+} VulkanWavefront;
+
+typedef struct {
+    alignas(4) uint32_t args[3];
+    alignas(4) uint32_t count;
+} SelectionHeader;
+
+typedef struct {
+    VkPipeline select;
+    VkPipeline compact[PIPELINE_VARIANTS];
+    VulkanDataBuffer list;
+} VulkanSelection;
+
+typedef struct {
+    VulkanImage history;
+    VulkanImage scratch;
+    VulkanImage keys;
+    VkPipeline reproject;
+    VkPipeline present;
+    vec4 previous[4];
+    BOOL moved;
+    BOOL active;
+} VulkanReprojection;
+
+typedef struct {
+    // albedo, normal and depth, then the two demodulated ping pong images
+    VulkanImage images[DENOISE_BINDINGS];
+    VkPipeline filter;
+} VulkanDenoiser;
+
+typedef struct {
+    // last traced color of every pixel, alpha marks pixels traced since the clear
+    VulkanImage lattice;
+    VkPipeline reconstruct;
+    uint32_t frame;
+    uint32_t settled;
+    BOOL active;
+} VulkanInterleave;
+
+typedef struct {
+    VkCommandPool pool;
+    VkCommandBuffer commands[CPUSWAP_MAX];
+} VulkanCommands;
+
+typedef struct {
+    VkDescriptorPool pool;
+    VkDescriptorSet sets[CPUSWAP_MAX];
+    VkDescriptorSetLayout layout;
+} VulkanDescriptors;
+
+typedef struct {
+    VkQueryPool pools[CPUSWAP_MAX];
+    uint32_t uploads[CPUSWAP_MAX];
+    BOOL pending[CPUSWAP_MAX];
+    uint64_t mask;
+    double period;
+    BOOL ready;
+} VulkanTimestamps;
+
+typedef struct {
+    // uploads go out in batches as they are recorded, each batch waits on the dispatches
+    // already queued through a drained semaphore and the swap's dispatch waits on all of them
+    VkQueue queue;
+    VkCommandPool pool;
+    VkCommandBuffer commands[CPUSWAP_MAX][TRANSFER_BATCHES];
+    VkSemaphore semaphores[CPUSWAP_MAX][TRANSFER_BATCHES];
+    VkSemaphore drained[CPUSWAP_MAX][TRANSFER_BATCHES];
+    uint32_t batches[CPUSWAP_MAX];
+    BOOL recording[CPUSWAP_MAX];
+    ARRLIST_VulkanDataBuffer staging[CPUSWAP_MAX];
+    ARRLIST_VkBuffer acquires[CPUSWAP_MAX];
+    uint32_t family;
+    uint32_t owner;
+    BOOL dedicated;
+} VulkanTransfer;
+
+typedef struct {
+    VulkanSyncro syncro;
+    VulkanCommands commands;
+    VulkanTimestamps timestamps;
+    VulkanTransfer transfer;
+    VkQueue queue;
+} VulkanScheduler;
+
+typedef struct {
+    VulkanDescriptors descriptors;
+    UBOArray ubos;
+    FramePushConstants frame;
+    SimpleCamera camera;
+    VulkanImage ages[CPUSWAP_MAX];
+    VulkanImage variances[CPUSWAP_MAX];
+    Vector2 extent;
+    PixelRegion region;
+    BOOL retrace[CPUSWAP_MAX];
+} VulkanRenderData;
+
+typedef struct {
+    VulkanPipeline pipeline;
+    VulkanWavefront wavefront;
+    VulkanSelection selection;
+    VulkanReprojection reprojection;
+    VulkanDenoiser denoiser;
+    VulkanInterleave interleave;
+    VulkanAccumulation accumulation;
+    VulkanRenderData renderdata;
+    VulkanImage targets[CPUSWAP_MAX];
+    VulkanDataBuffer bridges[CPUSWAP_MAX];
+    size_t slots;
+} VulkanRenderContext;
+
+typedef struct {
+    VulkanDataBuffer triangles;
+    VulkanDataBuffer materials;
+    VulkanDataBuffer bvh;
+    VulkanDataBuffer sdfs;
+    VulkanDataBuffer lights;
+} VulkanGeometry;
+
+typedef struct {
+    VulkanImage image;
+} VulkanTarget;
+
+typedef struct {
+    VulkanGeneral general;
+    VulkanMemory memory;
+    VulkanGeometry geometry;
+    VulkanRenderContext context;
+    VulkanScheduler scheduler;
+    VulkanTarget target;
+} VulkanCore;
+
+typedef struct {
+    ARRLIST_StaticString required;
+    ARRLIST_StaticString device;
+} VulkanExtensionData;
+
+typedef struct {
+    VulkanExtensionData extensions;
+    ARRLIST_StaticString validation;
+} VulkanMetadata;
+
+typedef struct {
+    VulkanCore core;
+    VulkanMetadata metadata;
+} VulkanObject;
+
+typedef struct {
+    RendererStats stats;
+    RendererBackend backend;
+    VulkanObject vulkan;
+    CPUObject cpu;
+    CPUSwap swapchain;
+    Vector2 dimensions;
+    Vector2 extent;
+    Geometry geometry;
+    SimpleCamera camera;
+    Vector2 viewport;
+    PixelRegion region;
+    RendererConfig config;
+} Renderer;
+
+#endif
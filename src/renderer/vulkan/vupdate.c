@@ -4,6 +4,7 @@
 #include "renderer/vulkan/vinit.h"
 #include "renderer/vulkan/vclean.h"
 #include "renderer/renderer.h"
+#include <stddef.h>
 
 Renderer* g_vupdt_renderer_ref = NULL;
 
@@ -52,51 +53,296 @@ void VUPDT_Materials(VulkanDataBuffer* materials) {
         materials->buffer);
 }
 
+void VUPDT_WavefrontStage(VkCommandBuffer command, VkPipeline pipeline, uint32_t queue) {
+    VulkanWavefront* wavefront = &(g_vupdt_renderer_ref->vulkan.core.context.wavefront);
+    vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+    vkCmdDispatchIndirect(command, wavefront->counters.buffer, offsetof(WavefrontCounters, args) + sizeof(uint32_t) * 4 * queue);
+    VUTIL_ComputeBarrier(command);
+}
+
+void VUPDT_RecordWavefront(VkCommandBuffer command, uint32_t variant) {
+    VulkanWavefront* wavefront = &(g_vupdt_renderer_ref->vulkan.core.context.wavefront);
+    WavefrontKernels* kernels = VINIT_WavefrontVariant(wavefront, variant);
+    if (kernels == NULL) return;
+    VkPipelineLayout layout = g_vupdt_renderer_ref->vulkan.core.context.pipeline.layout;
+    PixelRegion region = g_vupdt_renderer_ref->swapchain.regions[g_vupdt_renderer_ref->swapchain.index];
+    VkExtent2D tile = g_vupdt_renderer_ref->vulkan.core.context.pipeline.tile;
+    uint32_t groupsx = (region.width + tile.width - 1) / tile.width;
+    uint32_t groupsy = (region.height + tile.height - 1) / tile.height;
+
+    // queues are shared between swaps so wait for the previous frame
+    VUTIL_ComputeBarrier(command);
+
+    uint32_t samples = g_vupdt_renderer_ref->config.antialiasing ? 2 : 1;
+    for (uint32_t s = 0; s < samples; s++) {
+        vkCmdFillBuffer(command, wavefront->counters.buffer, 0, sizeof(uint32_t) * WAVEFRONT_QUEUES, 0);
+        VUTIL_ComputeBarrier(command);
+
+        // generate camera rays into the primary queue
+        uint32_t push[2] = { 0, s };
+        vkCmdPushConstants(command, layout, VK_SHADER_STAGE_COMPUTE_BIT, offsetof(FramePushConstants, queue), sizeof(push), push);
+        vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, kernels->generate);
+        vkCmdDispatch(command, groupsx, groupsy, 1);
+        VUTIL_ComputeBarrier(command);
+
+        // extend, connect and shade each queue, shading fills the next one
+        for (uint32_t q = 0; q < WAVEFRONT_QUEUES; q++) {
+            push[0] = q;
+            vkCmdPushConstants(command, layout, VK_SHADER_STAGE_COMPUTE_BIT, offsetof(FramePushConstants, queue), sizeof(push), push);
+            vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, kernels->args);
+            vkCmdDispatch(command, 1, 1, 1);
+            VUTIL_ComputeBarrier(command);
+            VUPDT_WavefrontStage(command, kernels->extend, q);
+            VUPDT_WavefrontStage(command, kernels->connect, q);
+            VUPDT_WavefrontStage(command, kernels->shade, q);
+        }
+    }
+
+    // write accumulated samples to the target
+    vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, kernels->resolve);
+    vkCmdDispatch(command, groupsx, groupsy, 1);
+}
+
+void VUPDT_RecordSelection(VkCommandBuffer command, uint32_t variant) {
+    VulkanSelection* selection = &(g_vupdt_renderer_ref->vulkan.core.context.selection);
+    VkPipeline compact = VINIT_SelectionVariant(selection, variant);
+    if (compact == VK_NULL_HANDLE) return;
+    PixelRegion region = g_vupdt_renderer_ref->swapchain.regions[g_vupdt_renderer_ref->swapchain.index];
+    VkExtent2D tile = g_vupdt_renderer_ref->vulkan.core.context.pipeline.tile;
+
+    // the list is shared between swaps so wait for the previous frame
+    VUTIL_ComputeBarrier(command);
+    SelectionHeader header = { { 0, 1, 1 }, 0 };
+    vkCmdUpdateBuffer(command, selection->list.buffer, 0, sizeof(SelectionHeader), &header);
+    VUTIL_ComputeBarrier(command);
+
+    // roll every visible pixel and compact the picked ones
+    vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, selection->select);
+    vkCmdDispatch(command, (region.width + tile.width - 1) / tile.width, (region.height + tile.height - 1) / tile.height, 1);
+    VUTIL_ComputeBarrier(command);
+
+    // trace only the picked pixels
+    vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, compact);
+    vkCmdDispatchIndirect(command, selection->list.buffer, offsetof(SelectionHeader, args));
+}
+
+void VUPDT_RecordReprojection(VkCommandBuffer command) {
+    VulkanReprojection* reprojection = &(g_vupdt_renderer_ref->vulkan.core.context.reprojection);
+    VkPipelineLayout layout = g_vupdt_renderer_ref->vulkan.core.context.pipeline.layout;
+    PixelRegion region = g_vupdt_renderer_ref->swapchain.regions[g_vupdt_renderer_ref->swapchain.index];
+    VkExtent2D tile = g_vupdt_renderer_ref->vulkan.core.context.pipeline.tile;
+    VkImageSubresourceRange range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+    // history is shared between swaps so wait for the previous frame
+    VUTIL_ComputeBarrier(command);
+    if (!reprojection->active) {
+        // drop whatever was left from the last time and retrace everything
+        VkClearColorValue clear = { 0 };
+        vkCmdClearColorImage(command, reprojection->history.image, VK_IMAGE_LAYOUT_GENERAL, &clear, 1, &range);
+        reprojection->active = TRUE;
+        reprojection->moved = TRUE;
+    }
+    if (!reprojection->moved) return;
+    reprojection->moved = FALSE;
+
+    VkClearColorValue empty = { 0 };
+    VkClearColorValue farthest = { .uint32 = { 0xFFFFFFFF, 0, 0, 0 } };
+    vkCmdClearColorImage(command, reprojection->scratch.image, VK_IMAGE_LAYOUT_GENERAL, &empty, 1, &range);
+    vkCmdClearColorImage(command, reprojection->keys.image, VK_IMAGE_LAYOUT_GENERAL, &farthest, 1, &range);
+    VUTIL_ComputeBarrier(command);
+
+    // resolve depth, scatter the nearest samples, then copy back and age the holes
+    vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, reprojection->reproject);
+    for (uint32_t pass = 0; pass < 3; pass++) {
+        vkCmdPushConstants(command, layout, VK_SHADER_STAGE_COMPUTE_BIT, offsetof(FramePushConstants, queue), sizeof(uint32_t), &pass);
+        vkCmdDispatch(command, (region.width + tile.width - 1) / tile.width, (region.height + tile.height - 1) / tile.height, 1);
+        VUTIL_ComputeBarrier(command);
+    }
+    uint32_t queue = 0;
+    vkCmdPushConstants(command, layout, VK_SHADER_STAGE_COMPUTE_BIT, offsetof(FramePushConstants, queue), sizeof(uint32_t), &queue);
+}
+
+void VUPDT_RecordDenoise(VkCommandBuffer command) {
+    VulkanDenoiser* denoiser = &(g_vupdt_renderer_ref->vulkan.core.context.denoiser);
+    VkPipeline filter = VINIT_DenoiserKernel(denoiser);
+    if (filter == VK_NULL_HANDLE) return;
+    VkPipelineLayout layout = g_vupdt_renderer_ref->vulkan.core.context.pipeline.layout;
+    PixelRegion region = g_vupdt_renderer_ref->swapchain.regions[g_vupdt_renderer_ref->swapchain.index];
+    VkExtent2D tile = g_vupdt_renderer_ref->vulkan.core.context.pipeline.tile;
+
+    // every pass doubles the tap spacing, the last one writes back into the target
+    vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, filter);
+    for (uint32_t pass = 0; pass < DENOISE_ITERATIONS; pass++) {
+        vkCmdPushConstants(command, layout, VK_SHADER_STAGE_COMPUTE_BIT, offsetof(FramePushConstants, queue), sizeof(uint32_t), &pass);
+        vkCmdDispatch(command, (region.width + tile.width - 1) / tile.width, (region.height + tile.height - 1) / tile.height, 1);
+        VUTIL_ComputeBarrier(command);
+    }
+    uint32_t queue = 0;
+    vkCmdPushConstants(command, layout, VK_SHADER_STAGE_COMPUTE_BIT, offsetof(FramePushConstants, queue), sizeof(uint32_t), &queue);
+}
+
+void VUPDT_RecordInterleave(VkCommandBuffer command) {
+    VulkanInterleave* interleave = &(g_vupdt_renderer_ref->vulkan.core.context.interleave);
+
+    // the lattice is shared between swaps so wait for the previous frame
+    VUTIL_ComputeBarrier(command);
+    if (interleave->active) return;
+
+    // drop whatever was left from the last time, empty pixels are filled from their neighbors
+    VkClearColorValue clear = { 0 };
+    VkImageSubresourceRange range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+    vkCmdClearColorImage(command, interleave->lattice.image, VK_IMAGE_LAYOUT_GENERAL, &clear, 1, &range);
+    VUTIL_ComputeBarrier(command);
+    interleave->active = TRUE;
+}
+
 void VUPDT_RecordCommand(VkCommandBuffer command) {
     VkCommandBufferBeginInfo beginInfo = { 0 };
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     VkResult result = vkBeginCommandBuffer(command, &beginInfo);
     LOG_ASSERT(result == VK_SUCCESS, "Failed to begin recording command buffer!");
 
-    // trace rays
-    {
-        vkCmdBindPipeline(
-            command,
-            VK_PIPELINE_BIND_POINT_COMPUTE,
-            g_vupdt_renderer_ref->vulkan.core.context.pipeline.pipeline);
+    VkExtent2D tile = g_vupdt_renderer_ref->vulkan.core.context.pipeline.tile;
+    size_t index = g_vupdt_renderer_ref->swapchain.index;
+
+    // only the visible region is dispatched, copied and uploaded
+    PixelRegion region = g_vupdt_renderer_ref->region;
+    g_vupdt_renderer_ref->swapchain.regions[index] = region;
+    uint32_t groupsx = (region.width + tile.width - 1) / tile.width;
+    uint32_t groupsy = (region.height + tile.height - 1) / tile.height;
+
+    // take over the buffers the transfer queue filled for this swap
+    VulkanTransfer* transfer = &(g_vupdt_renderer_ref->vulkan.core.scheduler.transfer);
+    for (size_t i = 0; i < transfer->acquires[index].size; i++)
+        VUTIL_BufferOwnership(command, transfer->acquires[index].data[i], FALSE);
+    ARRLIST_VkBuffer_clear(&(transfer->acquires[index]));
+
+    // stage timestamps are read back once this swap's fence signals
+    VulkanTimestamps* timestamps = &(g_vupdt_renderer_ref->vulkan.core.scheduler.timestamps);
+    if (timestamps->ready) {
+        vkCmdResetQueryPool(command, timestamps->pools[index], TIMESTAMP_DISPATCH, TIMESTAMP_UPLOADS);
+        vkCmdWriteTimestamp(command, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestamps->pools[index], TIMESTAMP_DISPATCH);
+        timestamps->pending[index] = TRUE;
+    }
+
+    // restart accumulation on this target
+    VulkanAccumulation* accumulation = &(g_vupdt_renderer_ref->vulkan.core.context.accumulation);
+    if (g_vupdt_renderer_ref->config.accumulate && accumulation->reset[index]) {
+        VkClearColorValue clear = { 0 };
+        VkImageSubresourceRange range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        vkCmdClearColorImage(command, accumulation->images[index].image, VK_IMAGE_LAYOUT_GENERAL, &clear, 1, &range);
+        VUTIL_ComputeBarrier(command);
+        accumulation->reset[index] = FALSE;
+    }
 
-        vkCmdBindDescriptorSets(
+    // ages from another trace resolution point at other pixels, so age everything out
+    VulkanRenderData* renderdata = &(g_vupdt_renderer_ref->vulkan.core.context.renderdata);
+    if (renderdata->retrace[index]) {
+        VkClearColorValue clear = { .float32 = { RETRACE_AGE, 0.0f, 0.0f, 0.0f } };
+        VkImageSubresourceRange range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        vkCmdClearColorImage(command, renderdata->ages[index].image, VK_IMAGE_LAYOUT_GENERAL, &clear, 1, &range);
+        VUTIL_ComputeBarrier(command);
+        renderdata->retrace[index] = FALSE;
+    }
+
+    // every kernel shares the layout, so bind and push once
+    vkCmdBindDescriptorSets(
+        command,
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        g_vupdt_renderer_ref->vulkan.core.context.pipeline.layout,
+        0,
+        1,
+        &(g_vupdt_renderer_ref->vulkan.core.context.renderdata.descriptors.sets[index]),
+        0,
+        NULL);
+    vkCmdPushConstants(
+        command,
+        g_vupdt_renderer_ref->vulkan.core.context.pipeline.layout,
+        VK_SHADER_STAGE_COMPUTE_BIT,
+        0,
+        sizeof(FramePushConstants),
+        &(g_vupdt_renderer_ref->vulkan.core.context.renderdata.frame));
+
+    // surface buffers are shared between swaps so wait for the previous frame's filter
+    if (g_vupdt_renderer_ref->config.denoise) VUTIL_ComputeBarrier(command);
+
+    // warp the last frame into this view so only holes and stale pixels need tracing, plain tracing if the kernels failed
+    VulkanReprojection* reprojection = &(g_vupdt_renderer_ref->vulkan.core.context.reprojection);
+    BOOL reprojecting = VUTIL_Reprojecting(&(g_vupdt_renderer_ref->config)) && VINIT_ReprojectionKernels(reprojection);
+    if (reprojecting) VUPDT_RecordReprojection(command);
+    reprojection->active = reprojecting;
+
+    // trace a fixed lattice of pixels and rebuild the rest from it, every pixel if the kernel failed
+    VulkanInterleave* interleave = &(g_vupdt_renderer_ref->vulkan.core.context.interleave);
+    uint32_t period = VUTIL_InterleavePeriod(&(g_vupdt_renderer_ref->config));
+    if (period > 1 && VINIT_InterleaveKernel(interleave) == VK_NULL_HANDLE) period = 1;
+    if (period > 1) {
+        VUPDT_RecordInterleave(command);
+    } else {
+        interleave->active = FALSE;
+        interleave->settled = 0;
+    }
+
+    // trace rays with the variant built for the current toggles
+    uint32_t variant = VUTIL_PipelineVariant(&(g_vupdt_renderer_ref->config));
+    if (g_vupdt_renderer_ref->config.wavefront && g_vupdt_renderer_ref->vulkan.core.context.wavefront.ready) {
+        VUPDT_RecordWavefront(command, variant);
+    } else if (g_vupdt_renderer_ref->config.frameless < 1.0f || period > 1) {
+        VUPDT_RecordSelection(command, variant);
+    } else {
+        VkPipeline pipeline = VINIT_PipelineVariant(&(g_vupdt_renderer_ref->vulkan.core.context.pipeline), variant);
+        if (pipeline != VK_NULL_HANDLE) {
+            vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+            vkCmdDispatch(command, groupsx, groupsy, 1);
+        }
+    }
+    VUTIL_ComputeBarrier(command);
+
+    // resolve the running sum, the reprojected history or the lattice into the readback target
+    if (g_vupdt_renderer_ref->config.accumulate) {
+        vkCmdBindPipeline(
             command,
             VK_PIPELINE_BIND_POINT_COMPUTE,
-            g_vupdt_renderer_ref->vulkan.core.context.pipeline.layout,
-            0,
-            1,
-            &(g_vupdt_renderer_ref->vulkan.core.context.renderdata.descriptors.sets[g_vupdt_renderer_ref->swapchain.index]),
-            0,
-            NULL);
-
-        float imgw = (uint32_t)g_vupdt_renderer_ref->dimensions.x;
-        float imgh = (uint32_t)g_vupdt_renderer_ref->dimensions.y;
-        vkCmdDispatch(command, ceil((imgw * imgh) / ((float)INVOCATION_GROUP_SIZE)), 1, 1);
+            g_vupdt_renderer_ref->vulkan.core.context.pipeline.resolve);
+
+        vkCmdDispatch(command, groupsx, groupsy, 1);
+        VUTIL_ComputeBarrier(command);
+    } else if (reprojecting) {
+        vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, reprojection->present);
+        vkCmdDispatch(command, groupsx, groupsy, 1);
+        VUTIL_ComputeBarrier(command);
+    } else if (period > 1) {
+        vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, interleave->reconstruct);
+        vkCmdDispatch(command, groupsx, groupsy, 1);
+        VUTIL_ComputeBarrier(command);
+        interleave->frame++;
+        if (interleave->settled < period) interleave->settled++;
     }
 
+    // smooth out the few samples each pixel got, stopping at surface edges
+    if (g_vupdt_renderer_ref->config.denoise) VUPDT_RecordDenoise(command);
+
+    if (timestamps->ready) vkCmdWriteTimestamp(command, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, timestamps->pools[index], TIMESTAMP_COPY);
+
     // Copy image to staging
-    {
-        VkBufferImageCopy region = { 0 };
-        region.bufferOffset = 0;
-        region.bufferRowLength = 0; // Tightly packed
-        region.bufferImageHeight = 0;
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel = 0;
-        region.imageSubresource.baseArrayLayer = 0;
-        region.imageSubresource.layerCount = 1;
-        region.imageOffset = (VkOffset3D){ 0, 0, 0 };
-        region.imageExtent = (VkExtent3D){ g_vupdt_renderer_ref->dimensions.x, g_vupdt_renderer_ref->dimensions.y, 1 };
+    if (region.width > 0 && region.height > 0) {
+        uint32_t imgw = (uint32_t)g_vupdt_renderer_ref->dimensions.x;
+        VkBufferImageCopy copy = { 0 };
+        copy.bufferOffset = ((VkDeviceSize)region.y * imgw + region.x) * 4;
+        copy.bufferRowLength = imgw; // keep the bridge laid out like the full image
+        copy.bufferImageHeight = 0;
+        copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copy.imageSubresource.mipLevel = 0;
+        copy.imageSubresource.baseArrayLayer = 0;
+        copy.imageSubresource.layerCount = 1;
+        copy.imageOffset = (VkOffset3D){ region.x, region.y, 0 };
+        copy.imageExtent = (VkExtent3D){ region.width, region.height, 1 };
         vkCmdCopyImageToBuffer(
             command,
-            g_vupdt_renderer_ref->vulkan.core.context.targets[g_vupdt_renderer_ref->swapchain.index].image,
-            VK_IMAGE_LAYOUT_GENERAL, g_vupdt_renderer_ref->vulkan.core.bridge.buffer, 1, &region);
+            g_vupdt_renderer_ref->vulkan.core.context.targets[index].image,
+            VK_IMAGE_LAYOUT_GENERAL, g_vupdt_renderer_ref->vulkan.core.context.bridges[index].buffer, 1, &copy);
     }
+    if (timestamps->ready) vkCmdWriteTimestamp(command, VK_PIPELINE_STAGE_TRANSFER_BIT, timestamps->pools[index], TIMESTAMP_END);
 
     // End command
     result = vkEndCommandBuffer(command);
@@ -105,19 +351,33 @@ void VUPDT_RecordCommand(VkCommandBuffer command) {
     }
 }
 
+void VUPDT_ImageDescriptors(VkDescriptorSet set, uint32_t first, VulkanImage* images, uint32_t count) {
+    VkDescriptorImageInfo infos[DESCRIPTOR_BINDINGS] = { 0 };
+    VkWriteDescriptorSet writes[DESCRIPTOR_BINDINGS] = { 0 };
+    for (uint32_t j = 0; j < count; j++) {
+        infos[j].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        infos[j].imageView = images[j].view;
+        writes[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[j].dstSet = set;
+        writes[j].dstBinding = first + j;
+        writes[j].dstArrayElement = 0;
+        writes[j].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[j].descriptorCount = 1;
+        writes[j].pImageInfo = &(infos[j]);
+    }
+    vkUpdateDescriptorSets(g_vupdt_renderer_ref->vulkan.core.general.interface, count, writes, 0, NULL);
+}
+
 void VUPDT_DescriptorSets(VulkanDescriptors* descriptors) {
-    uint32_t imgw = (uint32_t)g_vupdt_renderer_ref->dimensions.x;
-    uint32_t imgh = (uint32_t)g_vupdt_renderer_ref->dimensions.y;
-    for (size_t i = 0; i < CPUSWAP_LENGTH; i++) {
+    for (size_t i = 0; i < g_vupdt_renderer_ref->vulkan.core.context.slots; i++) {
         VkDescriptorBufferInfo bufferInfo = { 0 };
         bufferInfo.buffer = g_vupdt_renderer_ref->vulkan.core.context.renderdata.ubos.objects[i].buffer;
         bufferInfo.offset = 0;
         bufferInfo.range = sizeof(UniformBufferObject);
 
-        VkDescriptorBufferInfo storageBufferInfo = { 0 };
-        storageBufferInfo.buffer = g_vupdt_renderer_ref->vulkan.core.context.renderdata.ssbos[i].buffer;
-        storageBufferInfo.offset = 0;
-        storageBufferInfo.range = sizeof(RayGenerator) * imgw * imgh;
+        VkDescriptorImageInfo ageInfo = { 0 };
+        ageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        ageInfo.imageView = g_vupdt_renderer_ref->vulkan.core.context.renderdata.ages[i].view;
 
         VkDescriptorImageInfo imageInfo = { 0 };
         imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
@@ -158,7 +418,20 @@ void VUPDT_DescriptorSets(VulkanDescriptors* descriptors) {
         arrsize = arrsize > 0 ? arrsize : 1;
         lightBufferInfo.range = arrsize;
 
-        VkWriteDescriptorSet descriptorWrites[8] = { 0 };
+        VkDescriptorImageInfo accumulationInfo = { 0 };
+        accumulationInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        accumulationInfo.imageView = g_vupdt_renderer_ref->vulkan.core.context.accumulation.images[i].view;
+
+        VkDescriptorBufferInfo selectionInfo = { 0 };
+        selectionInfo.buffer = g_vupdt_renderer_ref->vulkan.core.context.selection.list.buffer;
+        selectionInfo.offset = 0;
+        selectionInfo.range = VK_WHOLE_SIZE;
+
+        VkDescriptorImageInfo varianceInfo = { 0 };
+        varianceInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        varianceInfo.imageView = g_vupdt_renderer_ref->vulkan.core.context.renderdata.variances[i].view;
+
+        VkWriteDescriptorSet descriptorWrites[11] = { 0 };
 
         descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         descriptorWrites[0].dstSet = descriptors->sets[i];
@@ -172,9 +445,9 @@ void VUPDT_DescriptorSets(VulkanDescriptors* descriptors) {
         descriptorWrites[1].dstSet = descriptors->sets[i];
         descriptorWrites[1].dstBinding = 1;
         descriptorWrites[1].dstArrayElement = 0;
-        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
         descriptorWrites[1].descriptorCount = 1;
-        descriptorWrites[1].pBufferInfo = &storageBufferInfo;
+        descriptorWrites[1].pImageInfo = &ageInfo;
 
         descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         descriptorWrites[2].dstSet = descriptors->sets[i];
@@ -224,45 +497,248 @@ void VUPDT_DescriptorSets(VulkanDescriptors* descriptors) {
         descriptorWrites[7].descriptorCount = 1;
         descriptorWrites[7].pBufferInfo = &lightBufferInfo;
 
-        vkUpdateDescriptorSets(g_vupdt_renderer_ref->vulkan.core.general.interface, 8, descriptorWrites, 0, NULL);
+        descriptorWrites[8].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[8].dstSet = descriptors->sets[i];
+        descriptorWrites[8].dstBinding = ACCUMULATION_BINDING;
+        descriptorWrites[8].dstArrayElement = 0;
+        descriptorWrites[8].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        descriptorWrites[8].descriptorCount = 1;
+        descriptorWrites[8].pImageInfo = &accumulationInfo;
+
+        descriptorWrites[9].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[9].dstSet = descriptors->sets[i];
+        descriptorWrites[9].dstBinding = SELECTION_BINDING;
+        descriptorWrites[9].dstArrayElement = 0;
+        descriptorWrites[9].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrites[9].descriptorCount = 1;
+        descriptorWrites[9].pBufferInfo = &selectionInfo;
+
+        descriptorWrites[10].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[10].dstSet = descriptors->sets[i];
+        descriptorWrites[10].dstBinding = VARIANCE_BINDING;
+        descriptorWrites[10].dstArrayElement = 0;
+        descriptorWrites[10].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        descriptorWrites[10].descriptorCount = 1;
+        descriptorWrites[10].pImageInfo = &varianceInfo;
+
+        vkUpdateDescriptorSets(g_vupdt_renderer_ref->vulkan.core.general.interface, 11, descriptorWrites, 0, NULL);
+
+        // reprojection, denoiser and interleave images are shared, every set points at the same ones
+        VulkanReprojection* reprojection = &(g_vupdt_renderer_ref->vulkan.core.context.reprojection);
+        VulkanImage reprojectionImages[REPROJECTION_BINDINGS] = {
+            reprojection->history,
+            reprojection->scratch,
+            reprojection->keys
+        };
+        VUPDT_ImageDescriptors(descriptors->sets[i], REPROJECTION_FIRST_BINDING, reprojectionImages, REPROJECTION_BINDINGS);
+        VUPDT_ImageDescriptors(descriptors->sets[i], DENOISE_FIRST_BINDING, g_vupdt_renderer_ref->vulkan.core.context.denoiser.images, DENOISE_BINDINGS);
+        VUPDT_ImageDescriptors(descriptors->sets[i], INTERLEAVE_BINDING, &(g_vupdt_renderer_ref->vulkan.core.context.interleave.lattice), 1);
+
+        // wavefront queues, once they exist
+        VulkanWavefront* wavefront = &(g_vupdt_renderer_ref->vulkan.core.context.wavefront);
+        if (!wavefront->ready) continue;
+        VulkanDataBuffer wavefrontBuffers[WAVEFRONT_BINDINGS] = {
+            wavefront->counters,
+            wavefront->queues,
+            wavefront->hits,
+            wavefront->visibility,
+            wavefront->pixels
+        };
+        VkDescriptorBufferInfo wavefrontBufferInfos[WAVEFRONT_BINDINGS] = { 0 };
+        VkWriteDescriptorSet wavefrontWrites[WAVEFRONT_BINDINGS] = { 0 };
+        for (uint32_t j = 0; j < WAVEFRONT_BINDINGS; j++) {
+            wavefrontBufferInfos[j].buffer = wavefrontBuffers[j].buffer;
+            wavefrontBufferInfos[j].offset = 0;
+            wavefrontBufferInfos[j].range = VK_WHOLE_SIZE;
+            wavefrontWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            wavefrontWrites[j].dstSet = descriptors->sets[i];
+            wavefrontWrites[j].dstBinding = WAVEFRONT_FIRST_BINDING + j;
+            wavefrontWrites[j].dstArrayElement = 0;
+            wavefrontWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            wavefrontWrites[j].descriptorCount = 1;
+            wavefrontWrites[j].pBufferInfo = &(wavefrontBufferInfos[j]);
+        }
+        vkUpdateDescriptorSets(g_vupdt_renderer_ref->vulkan.core.general.interface, WAVEFRONT_BINDINGS, wavefrontWrites, 0, NULL);
     }
 }
 
+void VUPDT_Extent(VulkanRenderData* renderdata) {
+    // pixels outside the region are never dispatched, so their ages and history froze while hidden
+    PixelRegion old = renderdata->region;
+    PixelRegion region = g_vupdt_renderer_ref->region;
+    renderdata->region = region;
+    BOOL exposed =
+        region.x < old.x || region.y < old.y ||
+        region.x + region.width > old.x + old.width ||
+        region.y + region.height > old.y + old.height;
+
+    // targets stay allocated at full size, a new extent or a wider region only retraces every swap
+    BOOL resized = memcmp(&(renderdata->extent), &(g_vupdt_renderer_ref->extent), sizeof(Vector2)) != 0;
+    if (!resized && !exposed) return;
+    memcpy(&(renderdata->extent), &(g_vupdt_renderer_ref->extent), sizeof(Vector2));
+    for (size_t i = 0; i < CPUSWAP_MAX; i++) renderdata->retrace[i] = TRUE;
+    g_vupdt_renderer_ref->vulkan.core.context.reprojection.active = FALSE;
+    g_vupdt_renderer_ref->vulkan.core.context.interleave.active = FALSE;
+    g_vupdt_renderer_ref->vulkan.core.context.interleave.settled = 0;
+}
+
+void VUPDT_SwapRing(VulkanRenderContext* context) {
+    size_t length = g_vupdt_renderer_ref->config.frames;
+    length = length < CPUSWAP_MIN ? CPUSWAP_MIN : (length > CPUSWAP_MAX ? CPUSWAP_MAX : length);
+    if (length == g_vupdt_renderer_ref->swapchain.length) return;
+
+    // drain the ring, every fence but the one about to be recorded ends up signaled
+    VkDevice device = g_vupdt_renderer_ref->vulkan.core.general.interface;
+    VulkanScheduler* scheduler = &(g_vupdt_renderer_ref->vulkan.core.scheduler);
+    vkDeviceWaitIdle(device);
+    for (size_t i = 0; i < CPUSWAP_MAX; i++) VUTIL_RecycleTransfers(i);
+
+    // slots past the old length get their images on first use, shrinking keeps them around
+    if (length > context->slots) {
+        BOOL grown = VINIT_SwapSlots(context, length);
+        LOG_ASSERT(grown, "Failed to grow swap ring");
+        VUPDT_DescriptorSets(&(context->renderdata.descriptors));
+    }
+
+    // hand the current slot's fence back signaled and claim the slot it maps to
+    size_t index = g_vupdt_renderer_ref->swapchain.index;
+    VkResult result = vkQueueSubmit(scheduler->queue, 0, NULL, scheduler->syncro.fences[index]);
+    LOG_ASSERT(result == VK_SUCCESS, "Failed to signal swap fence");
+    vkWaitForFences(device, 1, &(scheduler->syncro.fences[index]), VK_TRUE, UINT64_MAX);
+    index %= length;
+    vkResetFences(device, 1, &(scheduler->syncro.fences[index]));
+    g_vupdt_renderer_ref->swapchain.index = index;
+    g_vupdt_renderer_ref->swapchain.length = length;
+}
+
+void VUPDT_Accumulation(VulkanAccumulation* accumulation, BOOL changed) {
+    // frameless only picks which pixels trace, and the budget controller moves it every frame
+    RendererConfig config = g_vupdt_renderer_ref->config;
+    config.frameless = accumulation->config.frameless;
+    config.adaptive = accumulation->config.adaptive;
+    config.budget = accumulation->config.budget;
+
+    // anything that moves the image restarts every target
+    changed |= memcmp(&(accumulation->camera), &(g_vupdt_renderer_ref->camera), sizeof(SimpleCamera)) != 0;
+    changed |= memcmp(&(accumulation->config), &config, sizeof(RendererConfig)) != 0;
+    changed |= memcmp(&(accumulation->viewport), &(g_vupdt_renderer_ref->viewport), sizeof(Vector2)) != 0;
+    if (changed) {
+        memcpy(&(accumulation->camera), &(g_vupdt_renderer_ref->camera), sizeof(SimpleCamera));
+        memcpy(&(accumulation->config), &(g_vupdt_renderer_ref->config), sizeof(RendererConfig));
+        memcpy(&(accumulation->viewport), &(g_vupdt_renderer_ref->viewport), sizeof(Vector2));
+        for (size_t i = 0; i < CPUSWAP_MAX; i++) {
+            accumulation->samples[i] = 0;
+            accumulation->reset[i] = TRUE;
+        }
+    }
+    accumulation->samples[g_vupdt_renderer_ref->swapchain.index]++;
+}
+
+void VUPDT_FrameConstants(FramePushConstants* frame) {
+    // camera basis is only rebuilt when the camera moved
+    SimpleCamera* camera = &(g_vupdt_renderer_ref->vulkan.core.context.renderdata.camera);
+    if (memcmp(camera, &(g_vupdt_renderer_ref->camera), sizeof(SimpleCamera)) != 0 || frame->fov == 0.0f) {
+        #define RAYVEC_TO_GLMVEC(gv, rv) { gv[0] = rv.x; gv[1] = rv.y; gv[2] = rv.z; }
+        // keep the basis the history was traced with so it can be warped into the new one
+        VulkanReprojection* reprojection = &(g_vupdt_renderer_ref->vulkan.core.context.reprojection);
+        glm_vec4(frame->position, frame->fov, reprojection->previous[0]);
+        glm_vec4(frame->u, 0.0f, reprojection->previous[1]);
+        glm_vec4(frame->v, 0.0f, reprojection->previous[2]);
+        glm_vec4(frame->w, 0.0f, reprojection->previous[3]);
+        reprojection->moved = frame->fov != 0.0f;
+        g_vupdt_renderer_ref->vulkan.core.context.interleave.settled = 0;
+        memcpy(camera, &(g_vupdt_renderer_ref->camera), sizeof(SimpleCamera));
+        vec3 look;
+        vec3 up;
+        RAYVEC_TO_GLMVEC(frame->position, camera->position);
+        RAYVEC_TO_GLMVEC(look, camera->look);
+        glm_vec3_sub(look, frame->position, look);
+        RAYVEC_TO_GLMVEC(up, camera->up);
+        glm_vec3_normalize(up);
+        glm_vec3_normalize(look);
+        glm_vec3_negate_to(look, frame->w);
+        glm_vec3_crossn(up, frame->w, frame->u);
+        glm_vec3_crossn(frame->w, frame->u, frame->v);
+        frame->fov = glm_rad(camera->fov);
+        #undef RAYVEC_TO_GLMVEC
+    }
+	frame->frametime = RenderFrameTime();
+    frame->time = g_vupdt_renderer_ref->config.time;
+	frame->sequence++;
+    frame->samples = g_vupdt_renderer_ref->vulkan.core.context.accumulation.samples[g_vupdt_renderer_ref->swapchain.index];
+    frame->queue = 0;
+    frame->sample = 0;
+    frame->origin[0] = g_vupdt_renderer_ref->region.x;
+    frame->origin[1] = g_vupdt_renderer_ref->region.y;
+}
+
 void VUPDT_UniformBuffers(UBOArray* ubos) {
-    #define RAYVEC_TO_GLMVEC(gv, rv) { gv[0] = rv.x; gv[1] = rv.y; gv[2] = rv.z; }
     UniformBufferObject ubo = { 0 };
-	RAYVEC_TO_GLMVEC(ubo.position, g_vupdt_renderer_ref->camera.position);
-	RAYVEC_TO_GLMVEC(ubo.look, g_vupdt_renderer_ref->camera.look);
-    glm_vec3_sub(ubo.look, ubo.position, ubo.look);
-	RAYVEC_TO_GLMVEC(ubo.up, g_vupdt_renderer_ref->camera.up);
-    glm_vec3_normalize(ubo.up);
-    glm_vec3_normalize(ubo.look);
-    glm_vec3_negate_to(ubo.look, ubo.w);
-    glm_vec3_crossn(ubo.up, ubo.w, ubo.u);
-    glm_vec3_crossn(ubo.w, ubo.u, ubo.v);
-	ubo.fov = glm_rad(g_vupdt_renderer_ref->camera.fov);
-	ubo.width = g_vupdt_renderer_ref->dimensions.x;
-	ubo.height = g_vupdt_renderer_ref->dimensions.y;
+	ubo.width = g_vupdt_renderer_ref->extent.x;
+	ubo.height = g_vupdt_renderer_ref->extent.y;
     ubo.triangles = g_vupdt_renderer_ref->geometry.triangles.size;
     ubo.viewport[0] = g_vupdt_renderer_ref->viewport.x;
     ubo.viewport[1] = g_vupdt_renderer_ref->viewport.y;
     ubo.bvhsize = g_vupdt_renderer_ref->geometry.bvh.size;
-	ubo.frametime = RenderFrameTime();
 	ubo.frameless = g_vupdt_renderer_ref->config.frameless;
-	ubo.seed = rand();
-	ubo.shadows = (uint32_t)g_vupdt_renderer_ref->config.shadows;
-	ubo.reflections = (uint32_t)g_vupdt_renderer_ref->config.reflections;
-	ubo.lighting = (uint32_t)g_vupdt_renderer_ref->config.lighting;
-    ubo.raytrace = (uint32_t)g_vupdt_renderer_ref->config.raytrace;
-    ubo.sdf = (uint32_t)g_vupdt_renderer_ref->config.sdf;
     ubo.sdfsize = g_vupdt_renderer_ref->geometry.sdfs.size;
     ubo.sdfsmooth = g_vupdt_renderer_ref->config.sdfsmooth;
     ubo.maxmarches = g_vupdt_renderer_ref->config.maxmarches;
-    ubo.time = g_vupdt_renderer_ref->config.time;
-    ubo.antialiasing = (uint32_t)g_vupdt_renderer_ref->config.antialiasing;
     ubo.lightssize = g_vupdt_renderer_ref->geometry.lights.size;
-    memcpy(ubos->mapped[g_vupdt_renderer_ref->swapchain.index], &ubo, sizeof(UniformBufferObject));
-    #undef RAYVEC_TO_GLMVEC
+    ubo.accumulate = (uint32_t)g_vupdt_renderer_ref->config.accumulate;
+    ubo.variance = (uint32_t)g_vupdt_renderer_ref->config.variance;
+    // shaders only write history when the kernels that consume it were built
+    ubo.reproject = (uint32_t)(
+        VUTIL_Reprojecting(&(g_vupdt_renderer_ref->config)) &&
+        VINIT_ReprojectionKernels(&(g_vupdt_renderer_ref->vulkan.core.context.reprojection)));
+    memcpy(ubo.previous, g_vupdt_renderer_ref->vulkan.core.context.reprojection.previous, sizeof(ubo.previous));
+    ubo.denoise = (uint32_t)g_vupdt_renderer_ref->config.denoise;
+
+    // the phase picks which lattice pixels trace, settled once every one was traced from this view
+    VulkanInterleave* interleave = &(g_vupdt_renderer_ref->vulkan.core.context.interleave);
+    uint32_t period = VUTIL_InterleavePeriod(&(g_vupdt_renderer_ref->config));
+    if (period > 1 && VINIT_InterleaveKernel(interleave) == VK_NULL_HANDLE) period = 1;
+    ubo.interleave = period > 1 ? period : 0;
+    ubo.phase = interleave->frame % period;
+    ubo.settled = (uint32_t)(interleave->settled >= period);
+    ubo.slot = (uint32_t)g_vupdt_renderer_ref->swapchain.index;
+
+    // scene values rarely change, skip the write when this swap already has them
+    size_t index = g_vupdt_renderer_ref->swapchain.index;
+    if (memcmp(&(ubos->contents[index]), &ubo, sizeof(UniformBufferObject)) == 0) return;
+    memcpy(&(ubos->contents[index]), &ubo, sizeof(UniformBufferObject));
+    memcpy(ubos->mapped[index], &ubo, sizeof(UniformBufferObject));
+}
+
+void VUPDT_Timestamps(VulkanTimestamps* timestamps, size_t index) {
+    if (!timestamps->ready || !timestamps->pending[index]) return;
+    uint32_t uploads = timestamps->uploads[index];
+    timestamps->pending[index] = FALSE;
+    timestamps->uploads[index] = 0;
+
+    // the fence already signaled so this never stalls
+    uint64_t ticks[TIMESTAMP_QUERIES] = { 0 };
+    VkResult result = vkGetQueryPoolResults(
+        g_vupdt_renderer_ref->vulkan.core.general.interface,
+        timestamps->pools[index],
+        0,
+        TIMESTAMP_UPLOADS + 2 * uploads,
+        sizeof(ticks),
+        ticks,
+        sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS) return;
+
+    #define TICKS_TO_MS(a, b) ((double)((ticks[b] - ticks[a]) & timestamps->mask) * timestamps->period / 1000000.0)
+    SampleProfile(&(g_vupdt_renderer_ref->stats.dispatch), TICKS_TO_MS(TIMESTAMP_DISPATCH, TIMESTAMP_COPY));
+    SampleProfile(&(g_vupdt_renderer_ref->stats.copy), TICKS_TO_MS(TIMESTAMP_COPY, TIMESTAMP_END));
+    if (uploads > 0) {
+        double upload = 0.0;
+        for (uint32_t i = 0; i < uploads; i++)
+            upload += TICKS_TO_MS(TIMESTAMP_UPLOADS + 2 * i, TIMESTAMP_UPLOADS + 2 * i + 1);
+        SampleProfile(&(g_vupdt_renderer_ref->stats.upload), upload);
+    }
+    #undef TICKS_TO_MS
 }
 
 void VUPDT_SetVulkanUpdateContext(Renderer* renderer) {
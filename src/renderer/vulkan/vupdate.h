@@ -1,24 +1,44 @@
-#ifndef VUPDATE_H
-#define VUPDATE_H
-
-#include "renderer/vulkan/vstructs.h"
-
-void VUPDT_Lights(VulkanDataBuffer* lights);
-
-void VUPDT_BoundingVolumeHierarchy(VulkanDataBuffer* bvh);
-
-void VUPDT_Triangles(VulkanDataBuffer* triangles);
-
-void VUPDT_SDFs(VulkanDataBuffer* sdfs);
-
-void VUPDT_Materials(VulkanDataBuffer* materials);
-
-void VUPDT_RecordCommand(VkCommandBuffer command);
-
-void VUPDT_DescriptorSets(VulkanDescriptors* descriptors);
-
-void VUPDT_UniformBuffers(UBOArray* ubos);
-
-void VUPDT_SetVulkanUpdateContext(Renderer* renderer);
-
-#endif
+#ifndef VUPDATE_H
+#define VUPDATE_H
+
+#include "renderer/vulkan/vstructs.h"
+
+void VUPDT_Lights(VulkanDataBuffer* lights);
+
+void VUPDT_BoundingVolumeHierarchy(VulkanDataBuffer* bvh);
+
+void VUPDT_Triangles(VulkanDataBuffer* triangles);
+
+void VUPDT_SDFs(VulkanDataBuffer* sdfs);
+
+void VUPDT_Materials(VulkanDataBuffer* materials);
+
+void VUPDT_WavefrontStage(VkCommandBuffer command, VkPipeline pipeline, uint32_t queue);
+
+void VUPDT_RecordWavefront(VkCommandBuffer command, uint32_t variant);
+
+void VUPDT_RecordSelection(VkCommandBuffer command, uint32_t variant);
+
+void VUPDT_RecordReprojection(VkCommandBuffer command);
+void VUPDT_RecordDenoise(VkCommandBuffer command);
+void VUPDT_RecordInterleave(VkCommandBuffer command);
+void VUPDT_RecordCommand(VkCommandBuffer command);
+
+void VUPDT_ImageDescriptors(VkDescriptorSet set, uint32_t first, VulkanImage* images, uint32_t count);
+void VUPDT_DescriptorSets(VulkanDescriptors* descriptors);
+
+void VUPDT_Extent(VulkanRenderData* renderdata);
+
+void VUPDT_SwapRing(VulkanRenderContext* context);
+
+void VUPDT_Accumulation(VulkanAccumulation* accumulation, BOOL changed);
+
+void VUPDT_FrameConstants(FramePushConstants* frame);
+
+void VUPDT_UniformBuffers(UBOArray* ubos);
+
+void VUPDT_Timestamps(VulkanTimestamps* timestamps, size_t index);
+
+void VUPDT_SetVulkanUpdateContext(Renderer* renderer);
+
+#endif
@@ -1,310 +1,670 @@
-#include "vutils.h"
-#include "core/log.h"
-
-Renderer* g_vutil_renderer_ref = NULL;
-
-void VUTIL_SetVulkanUtilsContext(Renderer* renderer) {
-    g_vutil_renderer_ref = renderer;
-}
-
-VKAPI_ATTR VkBool32 VKAPI_CALL VUTIL_VulkanDebugCallback(
-    VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
-    VkDebugUtilsMessageTypeFlagsEXT messageType,
-    const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
-    void* pUserData) {
-    LOG_ASSERT(pUserData == NULL, "User data has not been set up to be handled");
-    if (messageSeverity == VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
-        LOG_WARN("%s[VULKAN] [%s]%s %s",
-            LOG_YELLOW,
-            (messageType == VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT ? "GENERAL" :
-                (messageType == VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT ? "VALIDATION" : "PERFORMANCE")),
-            LOG_RESET,
-            pCallbackData->pMessage);
-    } else if (messageSeverity == VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
-        LOG_TRACE("%s[FATAL] [VULKAN] [%s]%s %s",
-            LOG_RED,
-            (messageType == VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT ? "GENERAL" :
-                (messageType == VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT ? "VALIDATION" : "PERFORMANCE")),
-            LOG_RESET,
-            pCallbackData->pMessage);
-		exit(1);
-    }
-
-    return VK_FALSE;
-}
-
-BOOL VUTIL_CheckValidationLayerSupport() {
-    // grab all available layers
-    uint32_t layerCount;
-    vkEnumerateInstanceLayerProperties(&layerCount, NULL);
-    VkLayerProperties* availableLayers = EZALLOC(layerCount, sizeof(VkLayerProperties));
-    vkEnumerateInstanceLayerProperties(&layerCount, availableLayers);
-
-    // check if layers in validation layers exist in the available layers
-    for (size_t i = 0; i < g_vutil_renderer_ref->vulkan.metadata.validation.size; i++) {
-        BOOL layerFound = FALSE;
-        for (size_t j = 0; j < layerCount; j++) {
-            if (strcmp(ARRLIST_StaticString_get(&(g_vutil_renderer_ref->vulkan.metadata.validation), i), availableLayers[j].layerName) == 0) {
-                layerFound = TRUE;
-                break;
-            }
-        }
-        if (!layerFound) {
-            EZFREE(availableLayers);
-            return FALSE;
-        }
-    }
-    EZFREE(availableLayers);
-    return TRUE;
-}
-
-BOOL VUTIL_CheckGPUExtensionSupport(VkPhysicalDevice device) {
-    uint32_t extensionCount;
-    vkEnumerateDeviceExtensionProperties(device, NULL, &extensionCount, NULL);
-    VkExtensionProperties* availableExtensions = EZALLOC(extensionCount, sizeof(VkExtensionProperties));
-    vkEnumerateDeviceExtensionProperties(device, NULL, &extensionCount, availableExtensions);
-    for (size_t i = 0; i < g_vutil_renderer_ref->vulkan.metadata.extensions.device.size; i++) {
-        BOOL extensionFound = FALSE;
-        for (size_t j = 0; j < extensionCount; j++) {
-            if (strcmp(ARRLIST_StaticString_get(&(g_vutil_renderer_ref->vulkan.metadata.extensions.device), i), availableExtensions[j].extensionName) == 0) {
-                extensionFound = TRUE;
-                break;
-            }
-        }
-        if (!extensionFound) {
-            EZFREE(availableExtensions);
-            return FALSE;
-        }
-    }
-    EZFREE(availableExtensions);
-    return TRUE;
-}
-
-VulkanFamilyGroup VUTIL_FindQueueFamilies(VkPhysicalDevice gpu) {
-    VulkanFamilyGroup group = { 0 };
-    uint32_t queueFamilyCount = 0;
-    vkGetPhysicalDeviceQueueFamilyProperties(gpu, &queueFamilyCount, NULL);
-    VkQueueFamilyProperties* queueFamilies = EZALLOC(queueFamilyCount, sizeof(VkQueueFamilyProperties));
-    vkGetPhysicalDeviceQueueFamilyProperties(gpu, &queueFamilyCount, queueFamilies);
-    for (uint32_t i = 0; i < queueFamilyCount; i++) {
-        if ((queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) && (queueFamilies[i].queueFlags & VK_QUEUE_COMPUTE_BIT)) {
-            group.graphics = (Schrodingnum){ i, TRUE };
-            break;
-        }
-    }
-    EZFREE(queueFamilies);
-    return group;
-}
-
-VkShaderModule VUTIL_CreateShader(SimpleFile* file) {
-	VkShaderModuleCreateInfo createInfo = { 0 };
-	createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-	createInfo.codeSize = file->size;
-	createInfo.pCode = (const uint32_t*)(file->data);
-	VkShaderModule shader;
-	VkResult result = vkCreateShaderModule(g_vutil_renderer_ref->vulkan.core.general.interface, &createInfo, NULL, &shader);
-	LOG_ASSERT(result == VK_SUCCESS, "Failed to create shader module");
-	return shader;
-}
-
-void VUTIL_CopyHostToBuffer(void* hostdata, size_t size, VkDeviceSize buffersize, VkBuffer buffer) {    
-    VulkanDataBuffer stagingBuffer;
-    VUTIL_CreateBuffer(
-        buffersize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        &stagingBuffer);
-    void* data;
-    vkMapMemory(g_vutil_renderer_ref->vulkan.core.general.interface, stagingBuffer.memory, 0, buffersize, 0, &data);
-    memcpy(data, hostdata, size);
-    vkUnmapMemory(g_vutil_renderer_ref->vulkan.core.general.interface, stagingBuffer.memory);
-    VUTIL_CopyBuffer(stagingBuffer.buffer, buffer, buffersize);
-    VUTIL_DestroyBuffer(stagingBuffer);
-}
-
-Schrodingnum VUTIL_FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-    Schrodingnum result = { 0 };
-    VkPhysicalDeviceMemoryProperties memProperties = { 0 };
-    vkGetPhysicalDeviceMemoryProperties(g_vutil_renderer_ref->vulkan.core.general.gpu, &memProperties);
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) &&
-            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            result.value = i;
-            result.exists = TRUE;
-            break;
-        }
-    }
-    return result;
-}
-
-VkCommandBuffer VUTIL_BeginSingleTimeCommands() {
-    VkCommandBufferAllocateInfo allocInfo = { 0 };
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = g_vutil_renderer_ref->vulkan.core.scheduler.commands.pool;
-    allocInfo.commandBufferCount = 1;
-    VkCommandBuffer commandBuffer;
-    vkAllocateCommandBuffers(g_vutil_renderer_ref->vulkan.core.general.interface, &allocInfo, &commandBuffer);
-    VkCommandBufferBeginInfo beginInfo = { 0 };
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(commandBuffer, &beginInfo);
-    return commandBuffer;
-}
-
-void VUTIL_EndSingleTimeCommands(VkCommandBuffer commandBuffer) {
-    vkEndCommandBuffer(commandBuffer);
-    VkSubmitInfo submitInfo = { 0 };
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-    vkQueueSubmit(g_vutil_renderer_ref->vulkan.core.scheduler.queue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(g_vutil_renderer_ref->vulkan.core.scheduler.queue);
-    vkFreeCommandBuffers(g_vutil_renderer_ref->vulkan.core.general.interface, g_vutil_renderer_ref->vulkan.core.scheduler.commands.pool, 1, &commandBuffer);
-}
-
-void VUTIL_CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) {
-    VkCommandBuffer commandBuffer = VUTIL_BeginSingleTimeCommands();
-    VkBufferCopy copyRegion = { 0 };
-    copyRegion.size = size;
-    vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
-    VUTIL_EndSingleTimeCommands(commandBuffer);
-}
-
-void VUTIL_TransitionImageLayout(
-    VkImage image,
-    VkFormat format,
-    VkImageLayout oldLayout,
-    VkImageLayout newLayout,
-    uint32_t mipLevels) {
-    VkCommandBuffer commandBuffer = VUTIL_BeginSingleTimeCommands();
-    VkImageMemoryBarrier barrier = { 0 };
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = oldLayout;
-    barrier.newLayout = newLayout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = image;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = mipLevels;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-    VkPipelineStageFlags sourceStage;
-    VkPipelineStageFlags destinationStage;
-    if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    } else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    } else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_GENERAL) {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        destinationStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-    } else {
-        LOG_ASSERT(FALSE, "Unsupported layout transition!");
-    }
-    vkCmdPipelineBarrier(
-        commandBuffer,
-        sourceStage, destinationStage,
-        0,
-        0, NULL,
-        0, NULL,
-        1, &barrier);
-    VUTIL_EndSingleTimeCommands(commandBuffer);
-}
-
-void VUTIL_CreateBuffer(
-    VkDeviceSize size,
-    VkBufferUsageFlags usage,
-    VkMemoryPropertyFlags properties,
-    VulkanDataBuffer* buffer) {
-    VkBufferCreateInfo bufferInfo = { 0 };
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = size;
-    bufferInfo.usage = usage;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    VkResult result = vkCreateBuffer(g_vutil_renderer_ref->vulkan.core.general.interface, &bufferInfo, NULL, &(buffer->buffer));
-    LOG_ASSERT(result == VK_SUCCESS, "Unable to create buffer");
-
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(g_vutil_renderer_ref->vulkan.core.general.interface, buffer->buffer, &memRequirements);
-    VkMemoryAllocateInfo allocInfo = { 0 };
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    Schrodingnum memoryType = VUTIL_FindMemoryType(memRequirements.memoryTypeBits, properties);
-    LOG_ASSERT(memoryType.exists, "Unable to find memory for vertex buffer");
-    allocInfo.memoryTypeIndex = memoryType.value;
-    result = vkAllocateMemory(g_vutil_renderer_ref->vulkan.core.general.interface, &allocInfo, NULL, &(buffer->memory));
-    LOG_ASSERT(result == VK_SUCCESS, "Unable to allocate memory for buffer");
-
-    vkBindBufferMemory(g_vutil_renderer_ref->vulkan.core.general.interface, buffer->buffer, buffer->memory, 0);
-}
-
-void VUTIL_DestroyBuffer(VulkanDataBuffer buffer) {
-    vkDestroyBuffer(g_vutil_renderer_ref->vulkan.core.general.interface, buffer.buffer, NULL);
-    vkFreeMemory(g_vutil_renderer_ref->vulkan.core.general.interface, buffer.memory, NULL);
-}
-
-void VUTIL_CreateImage(
-    uint32_t width,
-    uint32_t height,
-    uint32_t mipLevels,
-    VkSampleCountFlagBits numSamples,
-    VkFormat format,
-    VkImageTiling tiling,
-    VkImageUsageFlags usage,
-    VkMemoryPropertyFlags properties,
-    VkImageAspectFlags aspectFlags,
-    VulkanImage* image) {
-    VkImageCreateInfo imageInfo = { 0 };
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent.width = width;
-    imageInfo.extent.height = height;
-    imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = mipLevels;
-    imageInfo.arrayLayers = 1;
-    imageInfo.format = format;
-    imageInfo.tiling = tiling;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage = usage;
-    imageInfo.samples = numSamples;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    VkResult result = vkCreateImage(g_vutil_renderer_ref->vulkan.core.general.interface, &imageInfo, NULL, &(image->image));
-    LOG_ASSERT(result == VK_SUCCESS, "Failed to create image!");
-
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(g_vutil_renderer_ref->vulkan.core.general.interface, image->image, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo = { 0 };
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    Schrodingnum memoryType = VUTIL_FindMemoryType(memRequirements.memoryTypeBits, properties);
-    LOG_ASSERT(memoryType.exists, "Unable to find valid memory type");
-    allocInfo.memoryTypeIndex = memoryType.value;
-    result = vkAllocateMemory(g_vutil_renderer_ref->vulkan.core.general.interface, &allocInfo, NULL, &(image->memory));
-    LOG_ASSERT(result == VK_SUCCESS, "Failed to allocate image memory!");
-
-    vkBindImageMemory(g_vutil_renderer_ref->vulkan.core.general.interface, image->image, image->memory, 0);
-    
-    VkImageViewCreateInfo viewInfo = { 0 };
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = image->image;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = format;
-    viewInfo.subresourceRange.aspectMask = aspectFlags;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = mipLevels;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
-
-    result = vkCreateImageView(g_vutil_renderer_ref->vulkan.core.general.interface, &viewInfo, NULL, &(image->view));
-    LOG_ASSERT(result == VK_SUCCESS, "failed to create texture image view!");
-}
+#include "vutils.h"
+#include "core/log.h"
+
+Renderer* g_vutil_renderer_ref = NULL;
+
+void VUTIL_SetVulkanUtilsContext(Renderer* renderer) {
+    g_vutil_renderer_ref = renderer;
+}
+
+VKAPI_ATTR VkBool32 VKAPI_CALL VUTIL_VulkanDebugCallback(
+    VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+    VkDebugUtilsMessageTypeFlagsEXT messageType,
+    const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+    void* pUserData) {
+    LOG_ASSERT(pUserData == NULL, "User data has not been set up to be handled");
+    if (messageSeverity == VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
+        LOG_WARN("%s[VULKAN] [%s]%s %s",
+            LOG_YELLOW,
+            (messageType == VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT ? "GENERAL" :
+                (messageType == VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT ? "VALIDATION" : "PERFORMANCE")),
+            LOG_RESET,
+            pCallbackData->pMessage);
+    } else if (messageSeverity == VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
+        LOG_TRACE("%s[FATAL] [VULKAN] [%s]%s %s",
+            LOG_RED,
+            (messageType == VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT ? "GENERAL" :
+                (messageType == VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT ? "VALIDATION" : "PERFORMANCE")),
+            LOG_RESET,
+            pCallbackData->pMessage);
+		exit(1);
+    }
+
+    return VK_FALSE;
+}
+
+BOOL VUTIL_CheckValidationLayerSupport() {
+    // grab all available layers
+    uint32_t layerCount;
+    vkEnumerateInstanceLayerProperties(&layerCount, NULL);
+    VkLayerProperties* availableLayers = EZALLOC(layerCount, sizeof(VkLayerProperties));
+    vkEnumerateInstanceLayerProperties(&layerCount, availableLayers);
+
+    // check if layers in validation layers exist in the available layers
+    for (size_t i = 0; i < g_vutil_renderer_ref->vulkan.metadata.validation.size; i++) {
+        BOOL layerFound = FALSE;
+        for (size_t j = 0; j < layerCount; j++) {
+            if (strcmp(ARRLIST_StaticString_get(&(g_vutil_renderer_ref->vulkan.metadata.validation), i), availableLayers[j].layerName) == 0) {
+                layerFound = TRUE;
+                break;
+            }
+        }
+        if (!layerFound) {
+            EZFREE(availableLayers);
+            return FALSE;
+        }
+    }
+    EZFREE(availableLayers);
+    return TRUE;
+}
+
+BOOL VUTIL_CheckGPUExtensionSupport(VkPhysicalDevice device) {
+    uint32_t extensionCount;
+    vkEnumerateDeviceExtensionProperties(device, NULL, &extensionCount, NULL);
+    VkExtensionProperties* availableExtensions = EZALLOC(extensionCount, sizeof(VkExtensionProperties));
+    vkEnumerateDeviceExtensionProperties(device, NULL, &extensionCount, availableExtensions);
+    for (size_t i = 0; i < g_vutil_renderer_ref->vulkan.metadata.extensions.device.size; i++) {
+        BOOL extensionFound = FALSE;
+        for (size_t j = 0; j < extensionCount; j++) {
+            if (strcmp(ARRLIST_StaticString_get(&(g_vutil_renderer_ref->vulkan.metadata.extensions.device), i), availableExtensions[j].extensionName) == 0) {
+                extensionFound = TRUE;
+                break;
+            }
+        }
+        if (!extensionFound) {
+            EZFREE(availableExtensions);
+            return FALSE;
+        }
+    }
+    EZFREE(availableExtensions);
+    return TRUE;
+}
+
+VulkanFamilyGroup VUTIL_FindQueueFamilies(VkPhysicalDevice gpu) {
+    VulkanFamilyGroup group = { 0 };
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(gpu, &queueFamilyCount, NULL);
+    VkQueueFamilyProperties* queueFamilies = EZALLOC(queueFamilyCount, sizeof(VkQueueFamilyProperties));
+    vkGetPhysicalDeviceQueueFamilyProperties(gpu, &queueFamilyCount, queueFamilies);
+    for (uint32_t i = 0; i < queueFamilyCount; i++) {
+        if ((queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) && (queueFamilies[i].queueFlags & VK_QUEUE_COMPUTE_BIT)) {
+            group.graphics = (Schrodingnum){ i, TRUE };
+            break;
+        }
+    }
+
+    // uploads prefer a copy only family, then an async compute one, compute families always copy
+    for (uint32_t i = 0; i < queueFamilyCount; i++) {
+        VkQueueFlags flags = queueFamilies[i].queueFlags;
+        if (queueFamilies[i].queueCount == 0 || (flags & VK_QUEUE_GRAPHICS_BIT)) continue;
+        if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & VK_QUEUE_COMPUTE_BIT)) {
+            group.transfer = (Schrodingnum){ i, TRUE };
+            break;
+        }
+        if ((flags & VK_QUEUE_COMPUTE_BIT) && !group.transfer.exists) group.transfer = (Schrodingnum){ i, TRUE };
+    }
+    EZFREE(queueFamilies);
+    return group;
+}
+
+VkShaderModule VUTIL_CreateShader(SimpleFile* file) {
+	VkShaderModuleCreateInfo createInfo = { 0 };
+	createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	createInfo.codeSize = file->size;
+	createInfo.pCode = (const uint32_t*)(file->data);
+	VkShaderModule shader;
+	VkResult result = vkCreateShaderModule(g_vutil_renderer_ref->vulkan.core.general.interface, &createInfo, NULL, &shader);
+	LOG_ASSERT(result == VK_SUCCESS, "Failed to create shader module");
+	return shader;
+}
+
+void VUTIL_CopyHostToBuffer(void* hostdata, size_t size, VkDeviceSize buffersize, VkBuffer buffer) {    
+    VulkanDataBuffer stagingBuffer;
+    VUTIL_CreateBuffer(
+        buffersize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        MEMORY_LINEAR,
+        &stagingBuffer);
+    memcpy(stagingBuffer.allocation.mapped, hostdata, size);
+
+    // batch onto the transfer queue so the copy overlaps whatever is still tracing
+    VulkanTransfer* transfer = &(g_vutil_renderer_ref->vulkan.core.scheduler.transfer);
+    size_t index = g_vutil_renderer_ref->swapchain.index;
+    VkCommandBuffer commandBuffer = transfer->dedicated ? VUTIL_TransferCommands(index) : VK_NULL_HANDLE;
+    if (commandBuffer != VK_NULL_HANDLE) {
+        VkBufferCopy copyRegion = { 0 };
+        copyRegion.size = buffersize;
+        vkCmdCopyBuffer(commandBuffer, stagingBuffer.buffer, buffer, 1, &copyRegion);
+        VUTIL_BufferOwnership(commandBuffer, buffer, TRUE);
+        ARRLIST_VulkanDataBuffer_add(&(transfer->staging[index]), stagingBuffer);
+        ARRLIST_VkBuffer_add(&(transfer->acquires[index]), buffer);
+        return;
+    }
+
+    // out of batches the copy lands on the compute queue, behind the frames in flight
+    if (transfer->dedicated) vkQueueWaitIdle(g_vutil_renderer_ref->vulkan.core.scheduler.queue);
+
+    // time the upload against the swap it is feeding
+    VulkanTimestamps* timestamps = &(g_vutil_renderer_ref->vulkan.core.scheduler.timestamps);
+    BOOL timed = timestamps->ready && timestamps->uploads[index] < TIMESTAMP_MAX_UPLOADS;
+    uint32_t query = TIMESTAMP_UPLOADS + 2 * timestamps->uploads[index];
+    commandBuffer = VUTIL_BeginSingleTimeCommands();
+    if (timed) {
+        vkCmdResetQueryPool(commandBuffer, timestamps->pools[index], query, 2);
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestamps->pools[index], query);
+    }
+    VkBufferCopy copyRegion = { 0 };
+    copyRegion.size = buffersize;
+    vkCmdCopyBuffer(commandBuffer, stagingBuffer.buffer, buffer, 1, &copyRegion);
+    if (timed) {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestamps->pools[index], query + 1);
+        timestamps->uploads[index]++;
+    }
+    VUTIL_EndSingleTimeCommands(commandBuffer);
+    VUTIL_DestroyBuffer(stagingBuffer);
+}
+
+Schrodingnum VUTIL_FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+    Schrodingnum result = { 0 };
+    VkPhysicalDeviceMemoryProperties memProperties = g_vutil_renderer_ref->vulkan.core.memory.properties;
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1 << i)) &&
+            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            result.value = i;
+            result.exists = TRUE;
+            break;
+        }
+    }
+    return result;
+}
+
+VkCommandBuffer VUTIL_BeginSingleTimeCommands() {
+    VkCommandBufferAllocateInfo allocInfo = { 0 };
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandPool = g_vutil_renderer_ref->vulkan.core.scheduler.commands.pool;
+    allocInfo.commandBufferCount = 1;
+    VkCommandBuffer commandBuffer;
+    vkAllocateCommandBuffers(g_vutil_renderer_ref->vulkan.core.general.interface, &allocInfo, &commandBuffer);
+    VkCommandBufferBeginInfo beginInfo = { 0 };
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    return commandBuffer;
+}
+
+void VUTIL_EndSingleTimeCommands(VkCommandBuffer commandBuffer) {
+    vkEndCommandBuffer(commandBuffer);
+    VkSubmitInfo submitInfo = { 0 };
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    vkQueueSubmit(g_vutil_renderer_ref->vulkan.core.scheduler.queue, 1, &submitInfo, VK_NULL_HANDLE);
+    vkQueueWaitIdle(g_vutil_renderer_ref->vulkan.core.scheduler.queue);
+    vkFreeCommandBuffers(g_vutil_renderer_ref->vulkan.core.general.interface, g_vutil_renderer_ref->vulkan.core.scheduler.commands.pool, 1, &commandBuffer);
+}
+
+VkCommandBuffer VUTIL_TransferCommands(size_t index) {
+    // null once the swap used up its batches, the caller then uploads synchronously
+    VulkanTransfer* transfer = &(g_vutil_renderer_ref->vulkan.core.scheduler.transfer);
+    uint32_t batch = transfer->batches[index];
+    if (transfer->recording[index]) return transfer->commands[index][batch];
+    if (batch == TRANSFER_BATCHES) return VK_NULL_HANDLE;
+    VkCommandBufferBeginInfo beginInfo = { 0 };
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(transfer->commands[index][batch], &beginInfo);
+    transfer->recording[index] = TRUE;
+    return transfer->commands[index][batch];
+}
+
+void VUTIL_BufferOwnership(VkCommandBuffer command, VkBuffer buffer, BOOL release) {
+    // the release half runs on the copy queue and the acquire half on the compute queue,
+    // each only names the stages its own queue supports
+    VulkanTransfer* transfer = &(g_vutil_renderer_ref->vulkan.core.scheduler.transfer);
+    VkBufferMemoryBarrier barrier = { 0 };
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = release ? VK_ACCESS_TRANSFER_WRITE_BIT : 0;
+    barrier.dstAccessMask = release ? 0 : VK_ACCESS_SHADER_READ_BIT;
+    barrier.srcQueueFamilyIndex = transfer->family;
+    barrier.dstQueueFamilyIndex = transfer->owner;
+    barrier.buffer = buffer;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(
+        command,
+        release ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        release ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 0, NULL, 1, &barrier, 0, NULL);
+}
+
+void VUTIL_SubmitTransfers(size_t index) {
+    VulkanTransfer* transfer = &(g_vutil_renderer_ref->vulkan.core.scheduler.transfer);
+    if (!transfer->recording[index]) return;
+    uint32_t batch = transfer->batches[index]++;
+    transfer->recording[index] = FALSE;
+    vkEndCommandBuffer(transfer->commands[index][batch]);
+
+    // an empty compute batch signals once every dispatch queued before it is done,
+    // so the copies can overwrite buffers the frames in flight are still reading
+    VkSubmitInfo drainInfo = { 0 };
+    drainInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    drainInfo.signalSemaphoreCount = 1;
+    drainInfo.pSignalSemaphores = &(transfer->drained[index][batch]);
+    VkResult result = vkQueueSubmit(g_vutil_renderer_ref->vulkan.core.scheduler.queue, 1, &drainInfo, VK_NULL_HANDLE);
+    LOG_ASSERT(result == VK_SUCCESS, "Failed to submit transfer drain");
+
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    VkSubmitInfo submitInfo = { 0 };
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores = &(transfer->drained[index][batch]);
+    submitInfo.pWaitDstStageMask = &waitStage;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &(transfer->commands[index][batch]);
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &(transfer->semaphores[index][batch]);
+    result = vkQueueSubmit(transfer->queue, 1, &submitInfo, VK_NULL_HANDLE);
+    LOG_ASSERT(result == VK_SUCCESS, "Failed to submit transfer command buffer");
+}
+
+void VUTIL_RecycleTransfers(size_t index) {
+    // the swap's fence signaled, so its last batch and the dispatch waiting on it are done
+    VulkanTransfer* transfer = &(g_vutil_renderer_ref->vulkan.core.scheduler.transfer);
+    for (size_t i = 0; i < transfer->staging[index].size; i++)
+        VUTIL_DestroyBuffer(transfer->staging[index].data[i]);
+    ARRLIST_VulkanDataBuffer_clear(&(transfer->staging[index]));
+    transfer->batches[index] = 0;
+}
+
+void VUTIL_CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) {
+    VkCommandBuffer commandBuffer = VUTIL_BeginSingleTimeCommands();
+    VkBufferCopy copyRegion = { 0 };
+    copyRegion.size = size;
+    vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+    VUTIL_EndSingleTimeCommands(commandBuffer);
+}
+
+void VUTIL_TransitionImageLayout(
+    VkImage image,
+    VkFormat format,
+    VkImageLayout oldLayout,
+    VkImageLayout newLayout,
+    uint32_t mipLevels) {
+    VkCommandBuffer commandBuffer = VUTIL_BeginSingleTimeCommands();
+    VkImageMemoryBarrier barrier = { 0 };
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = mipLevels;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+    VkPipelineStageFlags sourceStage;
+    VkPipelineStageFlags destinationStage;
+    if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    } else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    } else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_GENERAL) {
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        destinationStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    } else {
+        LOG_ASSERT(FALSE, "Unsupported layout transition!");
+    }
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        sourceStage, destinationStage,
+        0,
+        0, NULL,
+        0, NULL,
+        1, &barrier);
+    VUTIL_EndSingleTimeCommands(commandBuffer);
+}
+
+uint64_t VUTIL_Hash(const void* data, size_t size, uint64_t hash) {
+    // fnv-1a
+    const uint8_t* bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+PipelineCacheHeader VUTIL_PipelineCacheHeader() {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(g_vutil_renderer_ref->vulkan.core.general.gpu, &properties);
+    PipelineCacheHeader header = { 0 };
+    header.magic = PIPELINE_CACHE_MAGIC;
+    header.version = PIPELINE_CACHE_VERSION;
+    header.vendor = properties.vendorID;
+    header.device = properties.deviceID;
+    header.driver = properties.driverVersion;
+    memcpy(header.uuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    // any rebuilt shader invalidates the cache, order of the listing does not matter
+    FilePathList shaders = LoadDirectoryFilesEx("build/shaders", ".spv", false);
+    for (unsigned int i = 0; i < shaders.count; i++) {
+        int size = 0;
+        unsigned char* data = LoadFileData(shaders.paths[i], &size);
+        if (data == NULL) continue;
+        header.shaders += VUTIL_Hash(data, size, PIPELINE_CACHE_SEED);
+        UnloadFileData(data);
+    }
+    UnloadDirectoryFiles(shaders);
+    return header;
+}
+
+uint32_t VUTIL_PipelineVariant(RendererConfig* config) {
+    // bit order matches the shader specialization constant ids 2 to 7
+    uint32_t variant = 0;
+    variant |= config->shadows ? 1 << 0 : 0;
+    variant |= config->reflections ? 1 << 1 : 0;
+    variant |= config->lighting ? 1 << 2 : 0;
+    variant |= config->raytrace ? 1 << 3 : 0;
+    variant |= config->sdf ? 1 << 4 : 0;
+    variant |= config->antialiasing ? 1 << 5 : 0;
+    return variant;
+}
+
+BOOL VUTIL_Reprojecting(RendererConfig* config) {
+    // accumulation keeps its own history and wavefront has no primary depth to warp with
+    return config->reproject && !config->accumulate && !config->wavefront;
+}
+
+uint32_t VUTIL_InterleavePeriod(RendererConfig* config) {
+    // frames it takes the lattice to cover every pixel, 1 when every pixel is traced or rolled
+    static const uint32_t periods[] = { 1, 2, 4, 16 };
+    if (config->accumulate || config->wavefront || config->reproject) return 1;
+    return periods[config->interleave < 4 ? config->interleave : 3];
+}
+
+void VUTIL_ComputeBarrier(VkCommandBuffer command) {
+    // make compute and transfer writes visible to the next dispatch, indirect read or copy
+    VkMemoryBarrier barrier = { 0 };
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = 
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
+        VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(
+        command,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 1, &barrier, 0, NULL, 0, NULL);
+}
+
+void VUTIL_CreateBuffer(
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkMemoryPropertyFlags properties,
+    MemoryStrategy strategy,
+    VulkanDataBuffer* buffer) {
+    VkBufferCreateInfo bufferInfo = { 0 };
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkResult result = vkCreateBuffer(g_vutil_renderer_ref->vulkan.core.general.interface, &bufferInfo, NULL, &(buffer->buffer));
+    LOG_ASSERT(result == VK_SUCCESS, "Unable to create buffer");
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(g_vutil_renderer_ref->vulkan.core.general.interface, buffer->buffer, &memRequirements);
+    BOOL allocated = VUTIL_AllocateMemory(memRequirements, properties, strategy, &(buffer->allocation));
+    LOG_ASSERT(allocated, "Unable to allocate memory for buffer");
+
+    vkBindBufferMemory(g_vutil_renderer_ref->vulkan.core.general.interface, buffer->buffer, buffer->allocation.memory, buffer->allocation.offset);
+}
+
+void VUTIL_DestroyBuffer(VulkanDataBuffer buffer) {
+    vkDestroyBuffer(g_vutil_renderer_ref->vulkan.core.general.interface, buffer.buffer, NULL);
+    VUTIL_FreeMemory(&(buffer.allocation));
+}
+
+void VUTIL_CreateImage(
+    uint32_t width,
+    uint32_t height,
+    uint32_t mipLevels,
+    VkSampleCountFlagBits numSamples,
+    VkFormat format,
+    VkImageTiling tiling,
+    VkImageUsageFlags usage,
+    VkMemoryPropertyFlags properties,
+    VkImageAspectFlags aspectFlags,
+    VulkanImage* image) {
+    VkImageCreateInfo imageInfo = { 0 };
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent.width = width;
+    imageInfo.extent.height = height;
+    imageInfo.extent.depth = 1;
+    imageInfo.mipLevels = mipLevels;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = format;
+    imageInfo.tiling = tiling;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = usage;
+    imageInfo.samples = numSamples;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkResult result = vkCreateImage(g_vutil_renderer_ref->vulkan.core.general.interface, &imageInfo, NULL, &(image->image));
+    LOG_ASSERT(result == VK_SUCCESS, "Failed to create image!");
+
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(g_vutil_renderer_ref->vulkan.core.general.interface, image->image, &memRequirements);
+    BOOL allocated = VUTIL_AllocateMemory(memRequirements, properties, MEMORY_BUDDY, &(image->allocation));
+    LOG_ASSERT(allocated, "Failed to allocate image memory!");
+
+    vkBindImageMemory(g_vutil_renderer_ref->vulkan.core.general.interface, image->image, image->allocation.memory, image->allocation.offset);
+    
+    VkImageViewCreateInfo viewInfo = { 0 };
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image->image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = format;
+    viewInfo.subresourceRange.aspectMask = aspectFlags;
+    viewInfo.subresourceRange.baseMipLevel = 0;
+    viewInfo.subresourceRange.levelCount = mipLevels;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 1;
+
+    result = vkCreateImageView(g_vutil_renderer_ref->vulkan.core.general.interface, &viewInfo, NULL, &(image->view));
+    LOG_ASSERT(result == VK_SUCCESS, "failed to create texture image view!");
+}
+
+void VUTIL_DestroyImage(VulkanImage image) {
+    vkDestroyImageView(g_vutil_renderer_ref->vulkan.core.general.interface, image.view, NULL);
+    vkDestroyImage(g_vutil_renderer_ref->vulkan.core.general.interface, image.image, NULL);
+    VUTIL_FreeMemory(&(image.allocation));
+}
+
+BOOL VUTIL_MemoryBlock(VulkanMemoryBlock* block, uint32_t type, VkDeviceSize size, MemoryStrategy strategy, BOOL dedicated) {
+    VulkanMemory* memory = &(g_vutil_renderer_ref->vulkan.core.memory);
+    VkMemoryAllocateInfo allocInfo = { 0 };
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = size;
+    allocInfo.memoryTypeIndex = type;
+    VkResult result = vkAllocateMemory(g_vutil_renderer_ref->vulkan.core.general.interface, &allocInfo, NULL, &(block->memory));
+    if (result != VK_SUCCESS) return FALSE;
+    block->size = size;
+    block->dedicated = dedicated;
+
+    // a memory object can only be mapped once, so host visible blocks stay mapped for their lifetime
+    if (memory->properties.memoryTypes[type].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+        vkMapMemory(g_vutil_renderer_ref->vulkan.core.general.interface, block->memory, 0, VK_WHOLE_SIZE, 0, &(block->mapped));
+
+    // buddy tree stores one plus the largest free order under each node, zero when nothing is free
+    if (strategy == MEMORY_BUDDY && !dedicated) {
+        block->leaf = memory->leaf;
+        while ((block->leaf << block->orders) < size) block->orders++;
+        block->tree = EZALLOC((2ULL << block->orders) - 1, sizeof(uint8_t));
+        for (uint32_t depth = 0; depth <= block->orders; depth++)
+            for (size_t node = (1ULL << depth) - 1; node < (2ULL << depth) - 1; node++)
+                block->tree[node] = (uint8_t)(block->orders - depth + 1);
+    }
+
+    memory->report.reserved += size;
+    memory->report.blocks++;
+    if (dedicated) memory->report.dedicated++;
+    if (memory->report.reserved > memory->report.peak) memory->report.peak = memory->report.reserved;
+    return TRUE;
+}
+
+void VUTIL_ReleaseBlock(VulkanMemoryBlock* block) {
+    VulkanMemory* memory = &(g_vutil_renderer_ref->vulkan.core.memory);
+    vkFreeMemory(g_vutil_renderer_ref->vulkan.core.general.interface, block->memory, NULL);
+    if (block->tree != NULL) EZFREE(block->tree);
+    memory->report.reserved -= block->size;
+    memory->report.blocks--;
+    if (block->dedicated) memory->report.dedicated--;
+    *block = (VulkanMemoryBlock){ 0 };
+}
+
+void VUTIL_BuddyMerge(VulkanMemoryBlock* block, size_t node, uint32_t order) {
+    // two whole buddies make a whole parent, otherwise the parent keeps the larger free span
+    while (node > 0) {
+        node = (node - 1) / 2;
+        order++;
+        uint8_t left = block->tree[2 * node + 1];
+        uint8_t right = block->tree[2 * node + 2];
+        block->tree[node] = (left == order && right == order) ? (uint8_t)(order + 1) : (left > right ? left : right);
+    }
+}
+
+BOOL VUTIL_BuddyAllocate(VulkanMemoryBlock* block, VkDeviceSize size, VkDeviceSize alignment, VulkanAllocation* allocation) {
+    // nodes are aligned to their own size, so the order only has to cover the larger of the two
+    VkDeviceSize span = size > alignment ? size : alignment;
+    uint32_t order = 0;
+    while ((block->leaf << order) < span) order++;
+    if (order > block->orders || block->tree[0] <= order) return FALSE;
+
+    // descend into the tighter child so large spans stay whole for the next resize
+    size_t node = 0;
+    for (uint32_t level = block->orders; level > order; level--) {
+        size_t left = 2 * node + 1;
+        size_t right = left + 1;
+        BOOL fitsleft = block->tree[left] > order;
+        BOOL fitsright = block->tree[right] > order;
+        node = fitsleft && (!fitsright || block->tree[left] <= block->tree[right]) ? left : right;
+    }
+    block->tree[node] = 0;
+    VUTIL_BuddyMerge(block, node, order);
+
+    size_t first = (1ULL << (block->orders - order)) - 1;
+    allocation->offset = (node - first) * (block->leaf << order);
+    allocation->size = block->leaf << order;
+    allocation->order = order;
+    return TRUE;
+}
+
+void VUTIL_BuddyFree(VulkanMemoryBlock* block, VulkanAllocation* allocation) {
+    size_t first = (1ULL << (block->orders - allocation->order)) - 1;
+    size_t node = first + allocation->offset / (block->leaf << allocation->order);
+    block->tree[node] = (uint8_t)(allocation->order + 1);
+    VUTIL_BuddyMerge(block, node, allocation->order);
+}
+
+BOOL VUTIL_LinearAllocate(VulkanMemoryBlock* block, VkDeviceSize size, VkDeviceSize alignment, VulkanAllocation* allocation) {
+    // bump allocation, the block rewinds once everything in it has been freed
+    VkDeviceSize offset = (block->head + alignment - 1) / alignment * alignment;
+    if (offset + size > block->size) return FALSE;
+    block->head = offset + size;
+    allocation->offset = offset;
+    allocation->size = size;
+    allocation->order = 0;
+    return TRUE;
+}
+
+BOOL VUTIL_AllocateMemory(VkMemoryRequirements requirements, VkMemoryPropertyFlags properties, MemoryStrategy strategy, VulkanAllocation* allocation) {
+    VulkanMemory* memory = &(g_vutil_renderer_ref->vulkan.core.memory);
+    Schrodingnum type = VUTIL_FindMemoryType(requirements.memoryTypeBits, properties);
+    if (!type.exists) return FALSE;
+    ARRLIST_VulkanMemoryBlock* blocks = &(memory->pools[type.value].blocks[strategy]);
+    VkDeviceSize blocksize = strategy == MEMORY_LINEAR ? MEMORY_LINEAR_BLOCK_SIZE : MEMORY_BLOCK_SIZE;
+    BOOL dedicated = requirements.size > blocksize || requirements.alignment > blocksize;
+
+    // place it in the first pooled block with room
+    size_t index = blocks->size;
+    for (size_t i = 0; i < blocks->size && !dedicated; i++) {
+        VulkanMemoryBlock* block = &(blocks->data[i]);
+        if (block->memory == VK_NULL_HANDLE || block->dedicated) continue;
+        BOOL placed = strategy == MEMORY_LINEAR ?
+            VUTIL_LinearAllocate(block, requirements.size, requirements.alignment, allocation) :
+            VUTIL_BuddyAllocate(block, requirements.size, requirements.alignment, allocation);
+        if (placed) {
+            index = i;
+            break;
+        }
+    }
+
+    // otherwise open a block, reusing the slot of one that was released
+    if (index == blocks->size) {
+        for (size_t i = 0; i < blocks->size; i++) {
+            if (blocks->data[i].memory != VK_NULL_HANDLE) continue;
+            index = i;
+            break;
+        }
+        VulkanMemoryBlock block = { 0 };
+        if (!VUTIL_MemoryBlock(&block, type.value, dedicated ? requirements.size : blocksize, strategy, dedicated)) return FALSE;
+        if (dedicated) {
+            allocation->offset = 0;
+            allocation->size = requirements.size;
+            allocation->order = 0;
+        } else if (strategy == MEMORY_LINEAR) {
+            VUTIL_LinearAllocate(&block, requirements.size, requirements.alignment, allocation);
+        } else {
+            VUTIL_BuddyAllocate(&block, requirements.size, requirements.alignment, allocation);
+        }
+        if (index == blocks->size) ARRLIST_VulkanMemoryBlock_add(blocks, block);
+        else blocks->data[index] = block;
+    }
+
+    VulkanMemoryBlock* block = &(blocks->data[index]);
+    block->allocations++;
+    block->used += allocation->size;
+    allocation->memory = block->memory;
+    allocation->mapped = block->mapped != NULL ? (char*)block->mapped + allocation->offset : NULL;
+    allocation->type = type.value;
+    allocation->block = (uint32_t)index;
+    allocation->strategy = strategy;
+    memory->report.used += allocation->size;
+    memory->report.allocations++;
+    return TRUE;
+}
+
+void VUTIL_FreeMemory(VulkanAllocation* allocation) {
+    if (allocation->memory == VK_NULL_HANDLE) return;
+    VulkanMemory* memory = &(g_vutil_renderer_ref->vulkan.core.memory);
+    ARRLIST_VulkanMemoryBlock* blocks = &(memory->pools[allocation->type].blocks[allocation->strategy]);
+    VulkanMemoryBlock* block = &(blocks->data[allocation->block]);
+    if (block->tree != NULL) VUTIL_BuddyFree(block, allocation);
+    block->allocations--;
+    block->used -= allocation->size;
+    memory->report.used -= allocation->size;
+    memory->report.allocations--;
+    allocation->memory = VK_NULL_HANDLE;
+    if (block->allocations > 0) return;
+
+    // dedicated memory goes straight back, pooled blocks keep one empty spare to absorb resizes
+    block->head = 0;
+    size_t spares = 0;
+    for (size_t i = 0; i < blocks->size; i++) {
+        VulkanMemoryBlock* other = &(blocks->data[i]);
+        if (other->memory != VK_NULL_HANDLE && !other->dedicated && other->allocations == 0) spares++;
+    }
+    if (block->dedicated || spares > 1) VUTIL_ReleaseBlock(block);
+}
@@ -1,61 +1,99 @@
-#ifndef VUTILS_H
-#define VUTILS_H
-
-#include "core/file.h"
-#include <vulkan/vulkan.h>
-#include "renderer/vulkan/vstructs.h"
-
-void VUTIL_SetVulkanUtilsContext(Renderer* renderer);
-
-VKAPI_ATTR VkBool32 VKAPI_CALL VUTIL_VulkanDebugCallback(
-    VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
-    VkDebugUtilsMessageTypeFlagsEXT messageType,
-    const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
-    void* pUserData);
-
-BOOL VUTIL_CheckValidationLayerSupport();
-
-BOOL VUTIL_CheckGPUExtensionSupport(VkPhysicalDevice device);
-
-VulkanFamilyGroup VUTIL_FindQueueFamilies(VkPhysicalDevice gpu);
-
-VkShaderModule VUTIL_CreateShader(SimpleFile* file);
-
-void VUTIL_CopyHostToBuffer(void* hostdata, size_t size, VkDeviceSize buffersize, VkBuffer buffer);
-
-Schrodingnum VUTIL_FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
-
-VkCommandBuffer VUTIL_BeginSingleTimeCommands();
-
-void VUTIL_EndSingleTimeCommands(VkCommandBuffer commandBuffer);
-
-void VUTIL_CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
-
-void VUTIL_TransitionImageLayout(
-    VkImage image,
-    VkFormat format,
-    VkImageLayout oldLayout,
-    VkImageLayout newLayout,
-    uint32_t mipLevels);
-
-void VUTIL_CreateBuffer(
-    VkDeviceSize size,
-    VkBufferUsageFlags usage,
-    VkMemoryPropertyFlags properties,
-    VulkanDataBuffer* buffer);
-
-void VUTIL_DestroyBuffer(VulkanDataBuffer buffer);
-
-void VUTIL_CreateImage(
-    uint32_t width,
-    uint32_t height,
-    uint32_t mipLevels,
-    VkSampleCountFlagBits numSamples,
-    VkFormat format,
-    VkImageTiling tiling,
-    VkImageUsageFlags usage,
-    VkMemoryPropertyFlags properties,
-    VkImageAspectFlags aspectFlags,
-    VulkanImage* image);
-
+#ifndef VUTILS_H
+#define VUTILS_H
+
+#include "core/file.h"
+#include <vulkan/vulkan.h>
+#include "renderer/vulkan/vstructs.h"
+
+void VUTIL_SetVulkanUtilsContext(Renderer* renderer);
+
+VKAPI_ATTR VkBool32 VKAPI_CALL VUTIL_VulkanDebugCallback(
+    VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+    VkDebugUtilsMessageTypeFlagsEXT messageType,
+    const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+    void* pUserData);
+
+BOOL VUTIL_CheckValidationLayerSupport();
+
+BOOL VUTIL_CheckGPUExtensionSupport(VkPhysicalDevice device);
+
+VulkanFamilyGroup VUTIL_FindQueueFamilies(VkPhysicalDevice gpu);
+
+VkShaderModule VUTIL_CreateShader(SimpleFile* file);
+
+void VUTIL_CopyHostToBuffer(void* hostdata, size_t size, VkDeviceSize buffersize, VkBuffer buffer);
+
+Schrodingnum VUTIL_FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+
+VkCommandBuffer VUTIL_BeginSingleTimeCommands();
+
+void VUTIL_EndSingleTimeCommands(VkCommandBuffer commandBuffer);
+
+VkCommandBuffer VUTIL_TransferCommands(size_t index);
+
+void VUTIL_BufferOwnership(VkCommandBuffer command, VkBuffer buffer, BOOL release);
+
+void VUTIL_SubmitTransfers(size_t index);
+
+void VUTIL_RecycleTransfers(size_t index);
+
+void VUTIL_CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
+
+void VUTIL_TransitionImageLayout(
+    VkImage image,
+    VkFormat format,
+    VkImageLayout oldLayout,
+    VkImageLayout newLayout,
+    uint32_t mipLevels);
+
+uint64_t VUTIL_Hash(const void* data, size_t size, uint64_t hash);
+
+PipelineCacheHeader VUTIL_PipelineCacheHeader();
+
+uint32_t VUTIL_PipelineVariant(RendererConfig* config);
+BOOL VUTIL_Reprojecting(RendererConfig* config);
+
+uint32_t VUTIL_InterleavePeriod(RendererConfig* config);
+
+void VUTIL_ComputeBarrier(VkCommandBuffer command);
+
+void VUTIL_CreateBuffer(
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkMemoryPropertyFlags properties,
+    MemoryStrategy strategy,
+    VulkanDataBuffer* buffer);
+
+void VUTIL_DestroyBuffer(VulkanDataBuffer buffer);
+
+void VUTIL_CreateImage(
+    uint32_t width,
+    uint32_t height,
+    uint32_t mipLevels,
+    VkSampleCountFlagBits numSamples,
+    VkFormat format,
+    VkImageTiling tiling,
+    VkImageUsageFlags usage,
+    VkMemoryPropertyFlags properties,
+    VkImageAspectFlags aspectFlags,
+    VulkanImage* image);
+
+void VUTIL_DestroyImage(VulkanImage image);
+
+BOOL VUTIL_MemoryBlock(VulkanMemoryBlock* block, uint32_t type, VkDeviceSize size, MemoryStrategy strategy, BOOL dedicated);
+
+void VUTIL_ReleaseBlock(VulkanMemoryBlock* block);
+
+void VUTIL_BuddyMerge(VulkanMemoryBlock* block, size_t node, uint32_t order);
+
+BOOL VUTIL_BuddyAllocate(VulkanMemoryBlock* block, VkDeviceSize size, VkDeviceSize alignment, VulkanAllocation* allocation);
+
+void VUTIL_BuddyFree(VulkanMemoryBlock* block, VulkanAllocation* allocation);
+
+BOOL VUTIL_LinearAllocate(VulkanMemoryBlock* block, VkDeviceSize size, VkDeviceSize alignment, VulkanAllocation* allocation);
+
+BOOL VUTIL_AllocateMemory(VkMemoryRequirements requirements, VkMemoryPropertyFlags properties, MemoryStrategy strategy, VulkanAllocation* allocation);
+
+void VUTIL_FreeMemory(VulkanAllocation* allocation);
+
 #endif
\ No newline at end of file
@@ -1,60 +1,92 @@
-#include "diagnostics.h"
-#include "renderer/renderer.h"
-#include "data/assets.h"
-#include <easymemory.h>
-
-BOOL g_vsync_enabled = TRUE;
-BOOL g_time_paused = TRUE;
-
-float poop = 0.0f;
-
-void DrawDevPanel(float width, float height) {
-    UIDrawText("Application FPS: %d", (int)(1.0f / GetFrameTime()));
-    UIDrawText("Frame time: %.6f ms", (1000.0f * GetFrameTime()));
-    BOOL vsync = g_vsync_enabled;
-	UICheckboxLabeled("VSYNC:", &vsync);
-    if (vsync != g_vsync_enabled) {
-        g_vsync_enabled = vsync;
-        if (g_vsync_enabled)
-            SetWindowState(FLAG_VSYNC_HINT);
-        else
-            ClearWindowState(FLAG_VSYNC_HINT);
-    }
-    if (EZALLOCATED() > 1000000000) {
-        UIDrawText("Memory Usage: %.3f GB (%d bytes)", ((float)EZALLOCATED()) / 1000000000, (int)EZALLOCATED());
-    } else if (EZALLOCATED() > 1000000) {
-        UIDrawText("Memory Usage: %.3f MB (%d bytes)", ((float)EZALLOCATED()) / 1000000, (int)EZALLOCATED());
-    } else if (EZALLOCATED() > 1000) {
-        UIDrawText("Memory Usage: %.3f KB (%d bytes)", ((float)EZALLOCATED()) / 1000, (int)EZALLOCATED());
-    } else {
-        UIDrawText("Memory Usage: %d bytes", (int)EZALLOCATED());
-    }
-
-    UIMoveCursor(0, 20.0f);
-    UIDrawText("Renderer FPS: %d", (int)(1.0f / ((float)RenderTime() / 1000.0f)));
-    UIDrawText("Render time: %.6f ms", (float)RenderTime());
-    UIDrawText("Triangles: %d", (int)NumTriangles());
-    UIDrawText("SDF Objects: %d", (int)NumSDFs());
-    UIDrawText("Render Resolution: %dx%d", (int)RenderResolution().x, (int)RenderResolution().y);
-	UICheckboxLabeled("Time Paused:", &g_time_paused);
-    if (!g_time_paused) RenderConfig()->time += GetFrameTime();
-    UIDragFloatLabeled("Time:", &(RenderConfig()->time), 0.0f, 999999999.0f, 1.00f, width - 20);
-    UIDragFloatLabeled("Frameless:", &(RenderConfig()->frameless), 0.0f, 1.0f, 0.001f, width - 20);
-	UICheckboxLabeled("Anti-Aliasing:", &(RenderConfig()->antialiasing));
-
-    UIMoveCursor(0, 20.0f);
-	UICheckboxLabeled("Raytrace:", &(RenderConfig()->raytrace));
-	UICheckboxLabeled("Shadows:", &(RenderConfig()->shadows));
-	UICheckboxLabeled("Reflections:", &(RenderConfig()->reflections));
-	UICheckboxLabeled("Lighting:", &(RenderConfig()->lighting));
-
-    UIMoveCursor(0, 20.0f);
-	UICheckboxLabeled("SDF:", &(RenderConfig()->sdf));
-    UIDragUIntLabeled("Max Marches:", &(RenderConfig()->maxmarches), 0, 10000000, 1, width - 20);
-    UIDragFloatLabeled("Smooth:", &(RenderConfig()->sdfsmooth), 0.0f, 10000.0f, 0.05f, width - 20);
-}
-
-void ConfigureDiagnosticsPanel(Panel* panel) {
-    SetupPanel(panel, "Diagnostics");
-    panel->draw = DrawDevPanel;
-}
+#include "diagnostics.h"
+#include "renderer/renderer.h"
+#include "data/assets.h"
+#include <easymemory.h>
+
+BOOL g_vsync_enabled = TRUE;
+BOOL g_time_paused = TRUE;
+
+float poop = 0.0f;
+
+void DrawDevPanel(float width, float height) {
+    UIDrawText("Application FPS: %d", (int)(1.0f / GetFrameTime()));
+    UIDrawText("Frame time: %.6f ms", (1000.0f * GetFrameTime()));
+    BOOL vsync = g_vsync_enabled;
+	UICheckboxLabeled("VSYNC:", &vsync);
+    if (vsync != g_vsync_enabled) {
+        g_vsync_enabled = vsync;
+        if (g_vsync_enabled)
+            SetWindowState(FLAG_VSYNC_HINT);
+        else
+            ClearWindowState(FLAG_VSYNC_HINT);
+    }
+    if (EZALLOCATED() > 1000000000) {
+        UIDrawText("Memory Usage: %.3f GB (%d bytes)", ((float)EZALLOCATED()) / 1000000000, (int)EZALLOCATED());
+    } else if (EZALLOCATED() > 1000000) {
+        UIDrawText("Memory Usage: %.3f MB (%d bytes)", ((float)EZALLOCATED()) / 1000000, (int)EZALLOCATED());
+    } else if (EZALLOCATED() > 1000) {
+        UIDrawText("Memory Usage: %.3f KB (%d bytes)", ((float)EZALLOCATED()) / 1000, (int)EZALLOCATED());
+    } else {
+        UIDrawText("Memory Usage: %d bytes", (int)EZALLOCATED());
+    }
+
+    UIMoveCursor(0, 20.0f);
+    UIDrawText("Renderer FPS: %d", (int)(1.0f / ((float)RenderTime() / 1000.0f)));
+    UIDrawText("Render time: %.6f ms", (float)RenderTime());
+    if (RenderBackend() == BACKEND_VULKAN) {
+        UIDrawText("GPU upload: %.6f ms", RenderUploadTime());
+        UIDrawText("GPU dispatch: %.6f ms", RenderDispatchTime());
+        UIDrawText("GPU copy: %.6f ms", RenderCopyTime());
+        MemoryReport memory = ReportMemory();
+        UIDrawText("GPU memory: %.3f/%.3f MB (%.3f peak)", (float)memory.used / 1000000, (float)memory.reserved / 1000000, (float)memory.peak / 1000000);
+        UIDrawText("GPU blocks: %d (%d dedicated), %d allocations", (int)memory.blocks, (int)memory.dedicated, (int)memory.allocations);
+    }
+    UIDrawText("Triangles: %d", (int)NumTriangles());
+    UIDrawText("SDF Objects: %d", (int)NumSDFs());
+    UIDrawText("Render Resolution: %dx%d", (int)RenderResolution().x, (int)RenderResolution().y);
+    UIDrawText("Render Backend: %s", RenderBackend() == BACKEND_CPU ? "CPU" : "Vulkan");
+    if (RenderBackend() == BACKEND_CPU) UIDragUIntLabeled("Tile Size:", &(RenderConfig()->tilesize), 1, 256, 1, width - 20);
+    if (RenderBackend() == BACKEND_VULKAN) UICheckboxLabeled("Wavefront:", &(RenderConfig()->wavefront));
+    if (RenderBackend() == BACKEND_VULKAN) UICheckboxLabeled("Accumulate:", &(RenderConfig()->accumulate));
+    if (RenderBackend() == BACKEND_VULKAN) UICheckboxLabeled("Variance Sampling:", &(RenderConfig()->variance));
+    if (RenderBackend() == BACKEND_VULKAN) UICheckboxLabeled("Reproject:", &(RenderConfig()->reproject));
+    if (RenderBackend() == BACKEND_VULKAN) UIDragUIntLabeled("Interleave:", &(RenderConfig()->interleave), 0, 3, 1, width - 20);
+    if (RenderBackend() == BACKEND_VULKAN) UIDragUIntLabeled("Frames In Flight:", &(RenderConfig()->frames), CPUSWAP_MIN, CPUSWAP_MAX, 1, width - 20);
+    UICheckboxLabeled("Denoise:", &(RenderConfig()->denoise));
+	UICheckboxLabeled("Time Paused:", &g_time_paused);
+    if (!g_time_paused) RenderConfig()->time += GetFrameTime();
+    UIDragFloatLabeled("Time:", &(RenderConfig()->time), 0.0f, 999999999.0f, 1.00f, width - 20);
+	UICheckboxLabeled("Adaptive Frameless:", &(RenderConfig()->adaptive));
+	UICheckboxLabeled("Dynamic Resolution:", &(RenderConfig()->dynamicscale));
+    if (RenderConfig()->adaptive || RenderConfig()->dynamicscale) {
+        UIDragFloatLabeled("Frame Budget (ms):", &(RenderConfig()->budget), 1.0f, 1000.0f, 0.1f, width - 20);
+        UIDrawText("Budget time: %.6f ms", RenderBudgetTime());
+    }
+    if (RenderConfig()->adaptive) {
+        UIDrawText("Frameless: %.6f", RenderConfig()->frameless);
+    } else {
+        UIDragFloatLabeled("Frameless:", &(RenderConfig()->frameless), 0.0f, 1.0f, 0.001f, width - 20);
+    }
+    if (RenderConfig()->dynamicscale) {
+        UIDrawText("Render Scale: %.4f", RenderConfig()->scale);
+    } else {
+        UIDragFloatLabeled("Render Scale:", &(RenderConfig()->scale), RENDER_SCALE_MIN, 1.0f, 0.01f, width - 20);
+    }
+	UICheckboxLabeled("Anti-Aliasing:", &(RenderConfig()->antialiasing));
+
+    UIMoveCursor(0, 20.0f);
+	UICheckboxLabeled("Raytrace:", &(RenderConfig()->raytrace));
+	UICheckboxLabeled("Shadows:", &(RenderConfig()->shadows));
+	UICheckboxLabeled("Reflections:", &(RenderConfig()->reflections));
+	UICheckboxLabeled("Lighting:", &(RenderConfig()->lighting));
+
+    UIMoveCursor(0, 20.0f);
+	UICheckboxLabeled("SDF:", &(RenderConfig()->sdf));
+    UIDragUIntLabeled("Max Marches:", &(RenderConfig()->maxmarches), 0, 10000000, 1, width - 20);
+    UIDragFloatLabeled("Smooth:", &(RenderConfig()->sdfsmooth), 0.0f, 10000.0f, 0.05f, width - 20);
+}
+
+void ConfigureDiagnosticsPanel(Panel* panel) {
+    SetupPanel(panel, "Diagnostics");
+    panel->draw = DrawDevPanel;
+}